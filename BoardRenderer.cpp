@@ -0,0 +1,409 @@
+#include "GUI/BoardRenderer.h"
+#include <cmath>
+
+namespace {
+    // Цвета подложки и тени совпадают с прежним CardSprite::render
+    const sf::Color TextBackgroundColor(255, 255, 255, 100);
+    const sf::Color TextShadowColor(0, 0, 0, 100);
+    const float TextShadowOffset = 2.0f;
+    // Отступ вокруг глифа, как в sf::Text
+    const float GlyphPadding = 1.0f;
+    // Карточка без изображения в атласе
+    const std::size_t NoFace = static_cast<std::size_t>(-1);
+
+    bool isWhitespace(sf::Uint32 c) {
+        return c == ' ' || c == '\t' || c == '\n';
+    }
+}
+
+BoardRenderer::BoardRenderer()
+    : shapeVertices(sf::Quads), faceVertices(sf::Quads), glyphVertices(sf::Quads),
+      faceTexture(nullptr), glyphFont(nullptr), glyphCharacterSize(0),
+      visibleShapes(sf::Quads), visibleFaces(sf::Quads), visibleGlyphs(sf::Quads),
+      visibleCells(0, 0, 0, 0), gridCols(0), allVisible(true), alpha(1.0f) {
+}
+
+void BoardRenderer::setQuad(sf::Vertex* quad, const sf::FloatRect& rect, const sf::Color& color) {
+    quad[0].position = sf::Vector2f(rect.left, rect.top);
+    quad[1].position = sf::Vector2f(rect.left + rect.width, rect.top);
+    quad[2].position = sf::Vector2f(rect.left + rect.width, rect.top + rect.height);
+    quad[3].position = sf::Vector2f(rect.left, rect.top + rect.height);
+
+    for (int i = 0; i < 4; i++) {
+        quad[i].color = color;
+    }
+}
+
+void BoardRenderer::invalidate() {
+    cachedCards.clear();
+    cachedRevisions.clear();
+}
+
+bool BoardRenderer::needsRebuild(const std::vector<std::unique_ptr<CardSprite>>& cards) const {
+    // Полная проверка указателей стоила бы O(поля) в каждом кадре; новый
+    // набор карточек владелец сообщает через invalidate()
+    if (cards.size() != cachedCards.size()) {
+        return true;
+    }
+
+    return !cards.empty() && (cards.front().get() != cachedCards.front() ||
+                              cards.back().get() != cachedCards.back());
+}
+
+std::size_t BoardRenderer::countGlyphQuads(const CardSprite& card) const {
+    if (card.getHasImage()) {
+        return 0;
+    }
+
+    const sf::Text& text = card.getSymbolText();
+    const sf::String& str = text.getString();
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < str.getSize(); i++) {
+        if (!isWhitespace(str[i])) {
+            count++;
+        }
+    }
+
+    // Тень + сам символ
+    return count * 2;
+}
+
+void BoardRenderer::rebuild(const std::vector<std::unique_ptr<CardSprite>>& cards) {
+    cachedCards.assign(cards.size(), nullptr);
+    cachedRevisions.assign(cards.size(), 0);
+    glyphOffsets.assign(cards.size(), 0);
+    glyphCounts.assign(cards.size(), 0);
+    faceOffsets.assign(cards.size(), NoFace);
+    looseImageCards.clear();
+
+    faceTexture = nullptr;
+    glyphFont = nullptr;
+    glyphCharacterSize = 0;
+
+    // Изображения всех карточек берутся из одного атласа - один квад на карточку
+    std::size_t faceQuads = 0;
+    for (std::size_t i = 0; i < cards.size(); i++) {
+        const CardSprite& card = *cards[i];
+        if (!card.getHasImage()) {
+            continue;
+        }
+
+        const sf::Texture* texture = card.getImageSprite().getTexture();
+        if (!faceTexture) {
+            faceTexture = texture;
+        }
+
+        if (texture == faceTexture) {
+            faceOffsets[i] = faceQuads * 4;
+            faceQuads++;
+        } else {
+            looseImageCards.push_back(i);
+        }
+    }
+
+    // Раскладка глифов фиксируется при пересборке: текст карточки не меняется
+    // при смене состояния, меняется только его видимость
+    std::size_t glyphQuads = 0;
+    for (std::size_t i = 0; i < cards.size(); i++) {
+        const CardSprite& card = *cards[i];
+        std::size_t quads = countGlyphQuads(card);
+
+        if (quads > 0) {
+            const sf::Text& text = card.getSymbolText();
+            if (!glyphFont) {
+                glyphFont = text.getFont();
+                glyphCharacterSize = text.getCharacterSize();
+            } else if (text.getFont() != glyphFont || text.getCharacterSize() != glyphCharacterSize) {
+                // Все карточки поля используют один шрифт и размер
+                quads = 0;
+            }
+        }
+
+        glyphOffsets[i] = glyphQuads * 4;
+        glyphCounts[i] = quads;
+        glyphQuads += quads;
+    }
+
+    shapeVertices.resize(cards.size() * VerticesPerCard);
+    faceVertices.resize(faceQuads * 4);
+    glyphVertices.resize(glyphQuads * 4);
+
+    for (std::size_t i = 0; i < cards.size(); i++) {
+        writeCard(i, *cards[i]);
+        cachedCards[i] = cards[i].get();
+        cachedRevisions[i] = cards[i]->getRevision();
+    }
+}
+
+void BoardRenderer::update(const std::vector<std::unique_ptr<CardSprite>>& cards, int cols,
+                           const sf::IntRect& cells, float frameAlpha) {
+    alpha = frameAlpha;
+    bool changed = false;
+    if (needsRebuild(cards)) {
+        rebuild(cards);
+        changed = true;
+    }
+
+    if (cols != gridCols || cells != visibleCells) {
+        gridCols = cols;
+        visibleCells = cells;
+        changed = true;
+    }
+
+    int rows = cols > 0 ? static_cast<int>((cards.size() + cols - 1) / cols) : 0;
+    allVisible = cols <= 0 ||
+                 (visibleCells.left <= 0 && visibleCells.top <= 0 &&
+                  visibleCells.left + visibleCells.width >= cols &&
+                  visibleCells.top + visibleCells.height >= rows);
+
+    // Переворачивающиеся карточки зависят от alpha и пишутся каждый кадр
+    auto refresh = [&](std::size_t i) {
+        unsigned int revision = cards[i]->getRevision();
+        if (revision != cachedRevisions[i] || cards[i]->isAnimating()) {
+            writeCard(i, *cards[i]);
+            cachedRevisions[i] = revision;
+            changed = true;
+        }
+    };
+
+    if (allVisible) {
+        for (std::size_t i = 0; i < cards.size(); i++) {
+            refresh(i);
+        }
+        return;
+    }
+
+    // Невидимые карточки догоняют свою ревизию, когда попадут в вид
+    for (int row = visibleCells.top; row < visibleCells.top + visibleCells.height; row++) {
+        for (int col = visibleCells.left; col < visibleCells.left + visibleCells.width; col++) {
+            std::size_t i = static_cast<std::size_t>(row) * cols + col;
+            if (i < cards.size()) {
+                refresh(i);
+            }
+        }
+    }
+
+    if (changed) {
+        collectVisible();
+    }
+}
+
+bool BoardRenderer::isVisible(std::size_t index) const {
+    if (allVisible) {
+        return true;
+    }
+    int row = static_cast<int>(index / gridCols);
+    int col = static_cast<int>(index % gridCols);
+    return visibleCells.contains(col, row);
+}
+
+void BoardRenderer::collectVisible() {
+    visibleShapes.clear();
+    visibleFaces.clear();
+    visibleGlyphs.clear();
+
+    std::size_t cardCount = cachedCards.size();
+    for (int row = visibleCells.top; row < visibleCells.top + visibleCells.height; row++) {
+        for (int col = visibleCells.left; col < visibleCells.left + visibleCells.width; col++) {
+            std::size_t i = static_cast<std::size_t>(row) * gridCols + col;
+            if (i >= cardCount) {
+                continue;
+            }
+
+            for (std::size_t v = 0; v < VerticesPerCard; v++) {
+                visibleShapes.append(shapeVertices[i * VerticesPerCard + v]);
+            }
+            if (faceOffsets[i] != NoFace) {
+                for (std::size_t v = 0; v < 4; v++) {
+                    visibleFaces.append(faceVertices[faceOffsets[i] + v]);
+                }
+            }
+            for (std::size_t v = 0; v < glyphCounts[i] * 4; v++) {
+                visibleGlyphs.append(glyphVertices[glyphOffsets[i] + v]);
+            }
+        }
+    }
+}
+
+void BoardRenderer::writeCard(std::size_t index, const CardSprite& card) {
+    writeCardShape(index, card);
+    writeCardFace(index, card);
+    writeCardGlyphs(index, card);
+    applyFlip(index, card);
+}
+
+void BoardRenderer::applyFlip(std::size_t index, const CardSprite& card) {
+    float phase = card.getFlipPhase(alpha);
+    if (phase >= 1.0f) {
+        return;
+    }
+
+    // Карточка сжимается к вертикальной оси и раскрывается другой стороной
+    float scale = std::abs(1.0f - 2.0f * phase);
+    const sf::RectangleShape& shape = card.getShape();
+    float centerX = shape.getPosition().x + shape.getSize().x / 2;
+
+    auto squeeze = [centerX, scale](sf::Vertex* vertices, std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) {
+            vertices[i].position.x = centerX + (vertices[i].position.x - centerX) * scale;
+        }
+    };
+
+    squeeze(&shapeVertices[index * VerticesPerCard], VerticesPerCard);
+    if (faceOffsets[index] != NoFace) {
+        squeeze(&faceVertices[faceOffsets[index]], 4);
+    }
+    if (glyphCounts[index] > 0 && glyphFont) {
+        squeeze(&glyphVertices[glyphOffsets[index]], glyphCounts[index] * 4);
+    }
+}
+
+void BoardRenderer::writeCardShape(std::size_t index, const CardSprite& card) {
+    const sf::RectangleShape& shape = card.getShape();
+    sf::Vertex* quads = &shapeVertices[index * VerticesPerCard];
+
+    sf::FloatRect body(shape.getPosition().x, shape.getPosition().y,
+                       shape.getSize().x, shape.getSize().y);
+
+    // Рамка рисуется снаружи прямоугольника, как у sf::RectangleShape
+    float outline = shape.getOutlineThickness();
+    sf::FloatRect border(body.left - outline, body.top - outline,
+                         body.width + outline * 2, body.height + outline * 2);
+
+    setQuad(quads, border, shape.getOutlineColor());
+    setQuad(quads + 4, body, shape.getFillColor());
+
+    // Полупрозрачная подложка под текстовым символом открытой карточки
+    sf::FloatRect backgroundRect;
+    sf::Color backgroundColor = sf::Color::Transparent;
+
+    if (glyphCounts[index] > 0 && card.isFaceShown(alpha)) {
+        const sf::Text& text = card.getSymbolText();
+        sf::FloatRect textBounds = text.getLocalBounds();
+        if (textBounds.width > 0 && textBounds.height > 0) {
+            float width = textBounds.width + 20;
+            float height = textBounds.height + 20;
+            backgroundRect = sf::FloatRect(text.getPosition().x - width / 2,
+                                           text.getPosition().y - height / 2,
+                                           width, height);
+            backgroundColor = TextBackgroundColor;
+        }
+    }
+
+    setQuad(quads + 8, backgroundRect, backgroundColor);
+}
+
+void BoardRenderer::writeCardFace(std::size_t index, const CardSprite& card) {
+    if (faceOffsets[index] == NoFace) {
+        return;
+    }
+
+    const sf::Sprite& sprite = card.getImageSprite();
+    const sf::IntRect& region = sprite.getTextureRect();
+    sf::Vertex* quad = &faceVertices[faceOffsets[index]];
+
+    bool visible = card.isFaceShown(alpha);
+    setQuad(quad, sprite.getGlobalBounds(), visible ? sf::Color::White : sf::Color::Transparent);
+
+    float u1 = static_cast<float>(region.left);
+    float v1 = static_cast<float>(region.top);
+    float u2 = static_cast<float>(region.left + region.width);
+    float v2 = static_cast<float>(region.top + region.height);
+
+    quad[0].texCoords = sf::Vector2f(u1, v1);
+    quad[1].texCoords = sf::Vector2f(u2, v1);
+    quad[2].texCoords = sf::Vector2f(u2, v2);
+    quad[3].texCoords = sf::Vector2f(u1, v2);
+}
+
+void BoardRenderer::writeCardGlyphs(std::size_t index, const CardSprite& card) {
+    if (glyphCounts[index] == 0 || !glyphFont) {
+        return;
+    }
+
+    const sf::Text& text = card.getSymbolText();
+    const sf::String& str = text.getString();
+    bool bold = (text.getStyle() & sf::Text::Bold) != 0;
+    bool visible = card.isFaceShown(alpha);
+
+    sf::Color shadowColor = visible ? TextShadowColor : sf::Color::Transparent;
+    sf::Color fillColor = visible ? text.getFillColor() : sf::Color::Transparent;
+
+    sf::Vertex* quad = &glyphVertices[glyphOffsets[index]];
+
+    for (std::size_t i = 0; i < str.getSize(); i++) {
+        sf::Uint32 c = str[i];
+        if (isWhitespace(c)) {
+            continue;
+        }
+
+        const sf::Glyph& glyph = glyphFont->getGlyph(c, glyphCharacterSize, bold);
+
+        // findCharacterPos даёт верх строки; базовая линия ниже на размер символа
+        sf::Vector2f pen = text.findCharacterPos(i);
+        sf::FloatRect rect(pen.x + glyph.bounds.left - GlyphPadding,
+                           pen.y + glyphCharacterSize + glyph.bounds.top - GlyphPadding,
+                           glyph.bounds.width + GlyphPadding * 2,
+                           glyph.bounds.height + GlyphPadding * 2);
+
+        float u1 = glyph.textureRect.left - GlyphPadding;
+        float v1 = glyph.textureRect.top - GlyphPadding;
+        float u2 = glyph.textureRect.left + glyph.textureRect.width + GlyphPadding;
+        float v2 = glyph.textureRect.top + glyph.textureRect.height + GlyphPadding;
+
+        sf::FloatRect shadowRect = rect;
+        shadowRect.left += TextShadowOffset;
+        shadowRect.top += TextShadowOffset;
+
+        setQuad(quad, shadowRect, shadowColor);
+        setQuad(quad + 4, rect, fillColor);
+
+        for (int q = 0; q < 8; q += 4) {
+            quad[q + 0].texCoords = sf::Vector2f(u1, v1);
+            quad[q + 1].texCoords = sf::Vector2f(u2, v1);
+            quad[q + 2].texCoords = sf::Vector2f(u2, v2);
+            quad[q + 3].texCoords = sf::Vector2f(u1, v2);
+        }
+
+        quad += 8;
+    }
+}
+
+unsigned int BoardRenderer::render(sf::RenderTarget& target, const std::vector<std::unique_ptr<CardSprite>>& cards) const {
+    unsigned int drawCalls = 0;
+
+    const sf::VertexArray& shapes = allVisible ? shapeVertices : visibleShapes;
+    const sf::VertexArray& faces = allVisible ? faceVertices : visibleFaces;
+    const sf::VertexArray& glyphs = allVisible ? glyphVertices : visibleGlyphs;
+
+    if (shapes.getVertexCount() > 0) {
+        target.draw(shapes);
+        drawCalls++;
+    }
+
+    if (faceTexture && faces.getVertexCount() > 0) {
+        sf::RenderStates states;
+        states.texture = faceTexture;
+        target.draw(faces, states);
+        drawCalls++;
+    }
+
+    // Карточки, чья текстура не из общего атласа, рисуются по одной
+    for (std::size_t index : looseImageCards) {
+        const CardSprite& card = *cards[index];
+        if (card.isFaceShown(alpha) && isVisible(index)) {
+            target.draw(card.getImageSprite());
+            drawCalls++;
+        }
+    }
+
+    if (glyphFont && glyphs.getVertexCount() > 0) {
+        sf::RenderStates states;
+        states.texture = &glyphFont->getTexture(glyphCharacterSize);
+        target.draw(glyphs, states);
+        drawCalls++;
+    }
+
+    return drawCalls;
+}
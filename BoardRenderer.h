@@ -0,0 +1,71 @@
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+#include "GUI/CardSprite.h"
+
+// Пакетная отрисовка игрового поля.
+// Рамки, заливка и подложки всех карточек лежат в одном массиве вершин,
+// изображения - во втором (текстура атласа темы), буквы текстовых символов -
+// в третьем (текстура шрифта). Вершины карточки пересобираются только когда
+// меняется её ревизия (состояние, позиция, символ).
+// Если видна только часть поля, вершины видимых карточек копируются в
+// отдельные массивы - стоимость кадра зависит от экрана, а не от поля.
+class BoardRenderer {
+private:
+    // 3 квада на карточку: рамка, заливка, подложка текста
+    static const std::size_t VerticesPerCard = 12;
+
+    sf::VertexArray shapeVertices;
+    sf::VertexArray faceVertices;
+    sf::VertexArray glyphVertices;
+    const sf::Texture* faceTexture;
+    const sf::Font* glyphFont;
+    unsigned int glyphCharacterSize;
+
+    std::vector<const CardSprite*> cachedCards;
+    std::vector<unsigned int> cachedRevisions;
+    std::vector<std::size_t> glyphOffsets;
+    std::vector<std::size_t> glyphCounts;
+    std::vector<std::size_t> faceOffsets;
+    std::vector<std::size_t> looseImageCards;  // карточки с текстурой не из атласа
+    
+    // Видимая часть поля: столбцы (left, width) и строки (top, height)
+    sf::VertexArray visibleShapes;
+    sf::VertexArray visibleFaces;
+    sf::VertexArray visibleGlyphs;
+    sf::IntRect visibleCells;
+    int gridCols;
+    bool allVisible;
+    float alpha;  // доля до следующего тика логики - для переворотов
+
+    bool needsRebuild(const std::vector<std::unique_ptr<CardSprite>>& cards) const;
+    void rebuild(const std::vector<std::unique_ptr<CardSprite>>& cards);
+    void writeCard(std::size_t index, const CardSprite& card);
+    void writeCardShape(std::size_t index, const CardSprite& card);
+    void writeCardFace(std::size_t index, const CardSprite& card);
+    void writeCardGlyphs(std::size_t index, const CardSprite& card);
+    std::size_t countGlyphQuads(const CardSprite& card) const;
+    void applyFlip(std::size_t index, const CardSprite& card);
+    void collectVisible();
+    bool isVisible(std::size_t index) const;
+
+    static void setQuad(sf::Vertex* quad, const sf::FloatRect& rect, const sf::Color& color);
+
+public:
+    BoardRenderer();
+
+    // cols - ширина сетки поля, visibleCells - клетки, попавшие в вид,
+    // alpha - положение кадра между тиками логики (0..1)
+    void update(const std::vector<std::unique_ptr<CardSprite>>& cards, int cols,
+                const sf::IntRect& visibleCells, float alpha = 1.0f);
+    // Возвращает число вызовов draw
+    unsigned int render(sf::RenderTarget& target, const std::vector<std::unique_ptr<CardSprite>>& cards) const;
+    void invalidate();
+
+    std::size_t getVertexCount() const { return shapeVertices.getVertexCount() + faceVertices.getVertexCount() + glyphVertices.getVertexCount(); }
+};
+
+#endif
@@ -9,7 +9,9 @@ Button::Button(float x, float y, float width, float height,
       idleColor(sf::Color(70, 130, 180)),
       hoverColor(sf::Color(100, 149, 237)),
       activeColor(sf::Color(30, 144, 255)),
-      onClick(onClickFunc)
+      onClick(onClickFunc),
+      hovered(false),
+      pressed(false)
 {
     shape.setPosition(x, y);
     shape.setSize(sf::Vector2f(width, height));
@@ -25,33 +27,51 @@ Button::Button(float x, float y, float width, float height,
     text.setCharacterSize(24);
     text.setFillColor(sf::Color::White);
     
+    layoutText();
+}
+
+void Button::layoutText() {
     sf::FloatRect textBounds = text.getLocalBounds();
     text.setOrigin(textBounds.left + textBounds.width / 2.0f,
                    textBounds.top + textBounds.height / 2.0f);
-    text.setPosition(x + width / 2.0f, y + height / 2.0f);
+    
+    sf::Vector2f shapePos = shape.getPosition();
+    text.setPosition(shapePos.x + shape.getSize().x / 2.0f,
+                     shapePos.y + shape.getSize().y / 2.0f);
+    
+    shadowText = text;
+    shadowText.setFillColor(sf::Color(0, 0, 0, 150));
+    shadowText.move(2, 2);
 }
 
-void Button::update(const sf::Vector2f& mousePos) {
-    if (shape.getGlobalBounds().contains(mousePos)) {
+bool Button::update(const sf::Vector2f& mousePos) {
+    bool isHovered = shape.getGlobalBounds().contains(mousePos);
+    if (isHovered == hovered && !pressed) {
+        return false;
+    }
+    
+    hovered = isHovered;
+    pressed = false;
+    
+    if (hovered) {
         shape.setFillColor(hoverColor);
         shape.setOutlineColor(sf::Color::Yellow);
     } else {
         shape.setFillColor(idleColor);
         shape.setOutlineColor(sf::Color::White);
     }
+    return true;
 }
 
-void Button::render(sf::RenderWindow& window) {
-    window.draw(shape);
+unsigned int Button::render(sf::RenderTarget& target) {
+    target.draw(shape);
     
     if (fontPtr) {
-        sf::Text shadow = text;
-        shadow.setFillColor(sf::Color(0, 0, 0, 150));
-        shadow.move(2, 2);
-        window.draw(shadow);
+        target.draw(shadowText);
     }
     
-    window.draw(text);
+    target.draw(text);
+    return fontPtr ? 3 : 2;
 }
 
 void Button::handleEvent(const sf::Event& event, const sf::Vector2f& mousePos) {
@@ -59,6 +79,7 @@ void Button::handleEvent(const sf::Event& event, const sf::Vector2f& mousePos) {
         if (event.mouseButton.button == sf::Mouse::Left) {
             if (shape.getGlobalBounds().contains(mousePos)) {
                 shape.setFillColor(activeColor);
+                pressed = true;
                 if (onClick) {
                     onClick();
                 }
@@ -69,12 +90,7 @@ void Button::handleEvent(const sf::Event& event, const sf::Vector2f& mousePos) {
 
 void Button::setPosition(float x, float y) {
     shape.setPosition(x, y);
-    
-    sf::FloatRect textBounds = text.getLocalBounds();
-    text.setOrigin(textBounds.left + textBounds.width / 2.0f,
-                   textBounds.top + textBounds.height / 2.0f);
-    text.setPosition(x + shape.getSize().x / 2.0f, 
-                     y + shape.getSize().y / 2.0f);
+    layoutText();
 }
 
 sf::Vector2f Button::getPosition() const {
@@ -86,21 +102,16 @@ void Button::setColors(const sf::Color& idle, const sf::Color& hover, const sf::
     hoverColor = hover;
     activeColor = active;
     shape.setFillColor(idleColor);
+    hovered = false;
 }
 
 void Button::setText(const std::string& textStr) {
     text.setString(textStr);
-    
-    sf::FloatRect textBounds = text.getLocalBounds();
-    text.setOrigin(textBounds.left + textBounds.width / 2.0f,
-                   textBounds.top + textBounds.height / 2.0f);
-    
-    sf::Vector2f shapePos = shape.getPosition();
-    text.setPosition(shapePos.x + shape.getSize().x / 2.0f,
-                     shapePos.y + shape.getSize().y / 2.0f);
+    layoutText();
 }
 
 void Button::setFont(const sf::Font& font) {
     fontPtr = &font;
     text.setFont(font);
+    layoutText();
 }
@@ -9,6 +9,7 @@ class Button {
 private:
     sf::RectangleShape shape;
     sf::Text text;
+    sf::Text shadowText;  // готовая тень, чтобы не копировать текст каждый кадр
     const sf::Font* fontPtr;
     
     sf::Color idleColor;
@@ -16,21 +17,28 @@ private:
     sf::Color activeColor;
     
     std::function<void()> onClick;
+    bool hovered;
+    bool pressed;
+    
+    void layoutText();
     
 public:
-    Button() : fontPtr(nullptr) {}
+    Button() : fontPtr(nullptr), hovered(false), pressed(false) {}
     
     Button(float x, float y, float width, float height, 
            const std::string& textStr, 
            const sf::Font& font,
            std::function<void()> onClickFunc);
     
-    void update(const sf::Vector2f& mousePos);
-    void render(sf::RenderWindow& window);
+    // true, если вид кнопки изменился и её нужно перерисовать
+    bool update(const sf::Vector2f& mousePos);
+    // Возвращает число вызовов draw
+    unsigned int render(sf::RenderTarget& target);
     void handleEvent(const sf::Event& event, const sf::Vector2f& mousePos);
     
     void setPosition(float x, float y);
     sf::Vector2f getPosition() const;
+    bool contains(const sf::Vector2f& point) const { return shape.getGlobalBounds().contains(point); }
     void setColors(const sf::Color& idle, const sf::Color& hover, const sf::Color& active);
     void setText(const std::string& textStr);
     void setFont(const sf::Font& font);
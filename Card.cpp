@@ -8,21 +8,11 @@ namespace fs = std::filesystem;
 
 // Конструктор по умолчанию
 Card::Card() 
-    : id(-1), symbol(""), isFlipped(false), isMatched(false), 
-      theme(CardTheme::ANIMALS), isImage(false) {
+    : id(0), pairId(SymbolTable::InvalidId), flags(0), theme(CardTheme::ANIMALS) {
 }
 
-Card::Card(int id, const std::string& symbol, CardTheme theme)
-    : id(id), symbol(symbol), isFlipped(false), isMatched(false), theme(theme) {
-
-    std::string lowerSymbol = symbol;
-    std::transform(lowerSymbol.begin(), lowerSymbol.end(), lowerSymbol.begin(), ::tolower);
-    
-    isImage = (lowerSymbol.find(".png") != std::string::npos || 
-               lowerSymbol.find(".jpg") != std::string::npos ||
-               lowerSymbol.find(".jpeg") != std::string::npos ||
-               lowerSymbol.find(".bmp") != std::string::npos ||
-               lowerSymbol.find("img") != std::string::npos); // For test images
+Card::Card(std::uint16_t id, std::uint16_t pairId, CardTheme theme, bool isImage)
+    : id(id), pairId(pairId), flags(isImage ? ImageFlag : 0), theme(theme) {
 }
 
 std::vector<std::string> Card::getThemeSymbols(CardTheme theme) {
@@ -85,14 +75,14 @@ std::vector<std::string> Card::getThemeSymbols(CardTheme theme) {
     }
 }
 
-std::string Card::getDisplay() const {
-    if (isMatched) {
+std::string Card::getDisplay(const SymbolTable& symbols) const {
+    if (getIsMatched()) {
         return "✓";
-    } else if (isFlipped) {
-        if (isImage) {
+    } else if (getIsFlipped()) {
+        if (getIsImage()) {
             return "[IMG]";
         } else {
-            return symbol;
+            return symbols.getSymbol(pairId);
         }
     } else {
         return "?";
@@ -100,19 +90,19 @@ std::string Card::getDisplay() const {
 }
 
 void Card::flip() {
-    if (!isMatched) {
-        isFlipped = !isFlipped;
+    if (!getIsMatched()) {
+        flags ^= FlippedFlag;
     }
 }
 
 void Card::setMatched(bool matched) {
-    isMatched = matched;
     if (matched) {
-        isFlipped = true;
+        flags |= MatchedFlag | FlippedFlag;
+    } else {
+        flags &= static_cast<std::uint8_t>(~MatchedFlag);
     }
 }
 
 void Card::reset() {
-    isFlipped = false;
-    isMatched = false;
+    flags &= static_cast<std::uint8_t>(~(FlippedFlag | MatchedFlag));
 }
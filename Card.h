@@ -1,10 +1,12 @@
 #ifndef CARD_H
 #define CARD_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
+#include "SymbolTable.h"
 
-enum class CardTheme {
+enum class CardTheme : std::uint8_t {
     ANIMALS,
     FRUITS,
     EMOJI,
@@ -12,31 +14,46 @@ enum class CardTheme {
     SYMBOLS
 };
 
+// Название темы - на экранах и в столбце theme таблицы games
+inline const char* getThemeName(CardTheme theme) {
+    switch (theme) {
+        case CardTheme::ANIMALS: return "Animals";
+        case CardTheme::FRUITS: return "Fruits";
+        case CardTheme::EMOJI: return "Emoji";
+        case CardTheme::MEMES: return "Memes";
+        case CardTheme::SYMBOLS: return "Symbols";
+    }
+    return "Unknown";
+}
+
+// Карта - 6 байт: номер, номер пары (символ в SymbolTable темы) и флаги
 class Card {
 private:
-    int id;
-    std::string symbol;
-    bool isFlipped;
-    bool isMatched;
+    static const std::uint8_t FlippedFlag = 1;
+    static const std::uint8_t MatchedFlag = 2;
+    static const std::uint8_t ImageFlag = 4;
+    
+    std::uint16_t id;
+    std::uint16_t pairId;
+    std::uint8_t flags;
     CardTheme theme;
-    bool isImage;
 
 public:
     Card();
-    Card(int id, const std::string& symbol, CardTheme theme);
+    Card(std::uint16_t id, std::uint16_t pairId, CardTheme theme, bool isImage);
     
     int getId() const { return id; }
-    std::string getSymbol() const { return symbol; }
-    bool getIsFlipped() const { return isFlipped; }
-    bool getIsMatched() const { return isMatched; }
+    std::uint16_t getPairId() const { return pairId; }
+    bool getIsFlipped() const { return (flags & FlippedFlag) != 0; }
+    bool getIsMatched() const { return (flags & MatchedFlag) != 0; }
     CardTheme getTheme() const { return theme; }
-    bool getIsImage() const { return isImage; }
+    bool getIsImage() const { return (flags & ImageFlag) != 0; }
     
     void flip();
     void setMatched(bool matched);
     void reset();
     
-    std::string getDisplay() const;
+    std::string getDisplay(const SymbolTable& symbols) const;
     
     static std::vector<std::string> getThemeSymbols(CardTheme theme);
 };
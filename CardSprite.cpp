@@ -1,10 +1,10 @@
 #include "GUI/CardSprite.h"
 #include <iostream>
-#include <fstream>
 #include <algorithm>
 
-CardSprite::CardSprite(int id, const std::string& symbol, float x, float y, float size)
-    : id(id), symbol(symbol), state(CardState::HIDDEN), isClickable(true), hasImage(false) {
+CardSprite::CardSprite(int id, std::uint16_t pairId, float x, float y, float size)
+    : id(id), pairId(pairId), state(CardState::HIDDEN), isClickable(true), hasImage(false), revision(0),
+      flipProgress(1.0f), previousFlipProgress(1.0f), flipDuration(0.0f) {
     
     shape.setPosition(x, y);
     shape.setSize(sf::Vector2f(size, size));
@@ -19,43 +19,23 @@ CardSprite::CardSprite(int id, const std::string& symbol, float x, float y, floa
     centerText();
 }
 
-bool CardSprite::loadImage(const std::string& imagePath) {
-    if (imageTexture.loadFromFile(imagePath)) {
-        hasImage = true;
-        
-        imageSprite.setTexture(imageTexture);
-        
-        sf::FloatRect imageBounds = imageSprite.getLocalBounds();
-        float scaleX = (shape.getSize().x * 0.8f) / imageBounds.width;
-        float scaleY = (shape.getSize().y * 0.8f) / imageBounds.height;
-        float scale = std::min(scaleX, scaleY);
-        
-        imageSprite.setScale(scale, scale);
-        centerImage();
-        
-        return true;
-    }
+void CardSprite::setImage(const sf::Texture& atlas, const sf::IntRect& region) {
+    hasImage = true;
+    
+    imageSprite.setTexture(atlas);
+    imageSprite.setTextureRect(region);
+    
+    sf::FloatRect imageBounds = imageSprite.getLocalBounds();
+    float scaleX = (shape.getSize().x * 0.8f) / imageBounds.width;
+    float scaleY = (shape.getSize().y * 0.8f) / imageBounds.height;
+    float scale = std::min(scaleX, scaleY);
     
-    return false;
+    imageSprite.setScale(scale, scale);
+    centerImage();
+    revision++;
 }
 
 void CardSprite::setSymbol(const std::string& symbol, const sf::Font& mainFont) {
-    this->symbol = symbol;
-    
-    std::string lowerSymbol = symbol;
-    std::transform(lowerSymbol.begin(), lowerSymbol.end(), lowerSymbol.begin(), ::tolower);
-    
-    if (lowerSymbol.find(".png") != std::string::npos || 
-        lowerSymbol.find(".jpg") != std::string::npos ||
-        lowerSymbol.find(".jpeg") != std::string::npos ||
-        lowerSymbol.find(".bmp") != std::string::npos) {
-        
-        if (loadImage(symbol)) {
-            hasImage = true;
-            return;
-        }
-    }
-    
     hasImage = false;
     symbolText.setFont(mainFont);
     symbolText.setString(symbol);
@@ -64,6 +44,7 @@ void CardSprite::setSymbol(const std::string& symbol, const sf::Font& mainFont)
     symbolText.setStyle(sf::Text::Bold);
     
     centerText();
+    revision++;
 }
 
 void CardSprite::setClickable(bool clickable) {
@@ -104,6 +85,7 @@ void CardSprite::setPosition(float x, float y) {
     shape.setPosition(x, y);
     centerText();
     centerImage();
+    revision++;
 }
 
 void CardSprite::setSize(float size) {
@@ -111,10 +93,19 @@ void CardSprite::setSize(float size) {
     symbolText.setCharacterSize(static_cast<unsigned int>(size * 0.4f));
     centerText();
     centerImage();
+    revision++;
 }
 
 void CardSprite::setState(CardState newState) {
+    // Переворачивается только смена рубашки на лицо и обратно
+    bool turns = (state == CardState::HIDDEN) != (newState == CardState::HIDDEN);
+    if (turns && flipDuration > 0.0f) {
+        flipProgress = 0.0f;
+        previousFlipProgress = 0.0f;
+    }
+    
     state = newState;
+    revision++;
     
     switch (state) {
         case CardState::HIDDEN:
@@ -161,7 +152,30 @@ bool CardSprite::contains(const sf::Vector2f& point) const {
 }
 
 void CardSprite::update(float deltaTime) {
-    (void)deltaTime;
+    if (!isAnimating()) {
+        return;
+    }
+    
+    previousFlipProgress = flipProgress;
+    flipProgress = std::min(1.0f, flipProgress + deltaTime / flipDuration);
+    revision++;
+}
+
+void CardSprite::finishFlip() {
+    if (isAnimating()) {
+        flipProgress = 1.0f;
+        previousFlipProgress = 1.0f;
+        revision++;
+    }
+}
+
+float CardSprite::getFlipPhase(float alpha) const {
+    return previousFlipProgress + (flipProgress - previousFlipProgress) * alpha;
+}
+
+bool CardSprite::isFaceShown(float alpha) const {
+    bool faceUp = state != CardState::HIDDEN;
+    return getFlipPhase(alpha) < 0.5f ? !faceUp : faceUp;
 }
 
 void CardSprite::render(sf::RenderWindow& window) {
@@ -2,6 +2,7 @@
 #define CARDSPRITE_H
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <string>
 #include <memory>
 
@@ -15,20 +16,26 @@ class CardSprite {
 private:
     sf::RectangleShape shape;
     sf::Text symbolText;
-    sf::Sprite imageSprite;
-    sf::Texture imageTexture;
+    sf::Sprite imageSprite;  // ссылается на область в атласе темы
     
     int id;
-    std::string symbol;
+    std::uint16_t pairId;
     CardState state;
     bool isClickable;
     bool hasImage;
+    unsigned int revision;
+    
+    // Переворот: фаза 0..1 на двух последних тиках логики; кадр берёт
+    // промежуточное значение (интерполяция между тиками)
+    float flipProgress;
+    float previousFlipProgress;
+    float flipDuration;  // 0 - без анимации
     
     void centerText();
     void centerImage();
     
 public:
-    CardSprite(int id, const std::string& symbol, float x, float y, float size);
+    CardSprite(int id, std::uint16_t pairId, float x, float y, float size);
     
     void setPosition(float x, float y);
     void setSymbol(const std::string& symbol, const sf::Font& font);
@@ -36,7 +43,7 @@ public:
     void setState(CardState newState);
     void setClickable(bool clickable);
 
-    bool loadImage(const std::string& imagePath);
+    void setImage(const sf::Texture& atlas, const sf::IntRect& region);
     
     void flip();
     void reveal();
@@ -44,14 +51,28 @@ public:
     void markMatched();
     
     bool contains(const sf::Vector2f& point) const;
+    // Один тик логики фиксированной длины
     void update(float deltaTime);
+    void setFlipDuration(float seconds) { flipDuration = seconds; }
+    void finishFlip();
+    bool isAnimating() const { return previousFlipProgress < 1.0f; }
+    // Фаза переворота между прошлым и текущим тиком; alpha - доля до следующего
+    float getFlipPhase(float alpha) const;
+    // Видна ли лицевая сторона: до середины переворота - ещё прежняя сторона
+    bool isFaceShown(float alpha) const;
     void render(sf::RenderWindow& window);
     
     int getId() const { return id; }
-    std::string getSymbol() const { return symbol; }
+    std::uint16_t getPairId() const { return pairId; }
     CardState getState() const { return state; }
     bool getIsClickable() const { return isClickable; }
     bool getHasImage() const { return hasImage; }
+    
+    // Для пакетной отрисовки (BoardRenderer)
+    unsigned int getRevision() const { return revision; }
+    const sf::RectangleShape& getShape() const { return shape; }
+    const sf::Text& getSymbolText() const { return symbolText; }
+    const sf::Sprite& getImageSprite() const { return imageSprite; }
 };
 
 #endif
@@ -167,53 +167,63 @@ void ContactForm::handleTextInput(sf::Uint32 unicode) {
     }
 }
 
-void ContactForm::update(const sf::Vector2f& mousePos) {
+bool ContactForm::update(const sf::Vector2f& mousePos) {
     // Обновление цвета кнопок при наведении
-    if (sendButton.getGlobalBounds().contains(mousePos)) {
-        sendButton.setFillColor(sf::Color(0, 200, 0));
-    } else {
-        sendButton.setFillColor(sf::Color(0, 150, 0));
-    }
+    sf::Color sendColor = sendButton.getGlobalBounds().contains(mousePos) ?
+                          sf::Color(0, 200, 0) : sf::Color(0, 150, 0);
+    sf::Color backColor = backButton.getGlobalBounds().contains(mousePos) ?
+                          sf::Color(200, 0, 0) : sf::Color(150, 0, 0);
     
-    if (backButton.getGlobalBounds().contains(mousePos)) {
-        backButton.setFillColor(sf::Color(200, 0, 0));
-    } else {
-        backButton.setFillColor(sf::Color(150, 0, 0));
+    // Сообщаем об изменении, чтобы форму перерисовали
+    if (sendButton.getFillColor() == sendColor && backButton.getFillColor() == backColor) {
+        return false;
     }
+    
+    sendButton.setFillColor(sendColor);
+    backButton.setFillColor(backColor);
+    return true;
 }
 
-void ContactForm::render(sf::RenderWindow& window) {
-    window.draw(titleText);
-    window.draw(nameLabel);
-    window.draw(emailLabel);
-    window.draw(messageLabel);
+unsigned int ContactForm::render(sf::RenderTarget& target) {
+    unsigned int drawCalls = 0;
+    auto draw = [&](const sf::Drawable& drawable) {
+        target.draw(drawable);
+        drawCalls++;
+    };
+    
+    draw(titleText);
+    draw(nameLabel);
+    draw(emailLabel);
+    draw(messageLabel);
     
-    window.draw(nameBox);
-    window.draw(emailBox);
-    window.draw(messageBox);
+    draw(nameBox);
+    draw(emailBox);
+    draw(messageBox);
     
-    window.draw(sendButton);
-    window.draw(sendButtonText);
-    window.draw(backButton);
-    window.draw(backButtonText);
+    draw(sendButton);
+    draw(sendButtonText);
+    draw(backButton);
+    draw(backButtonText);
     
     // Отрисовка введенного текста
     sf::Text nameDisplay(nameInput + (activeField == ActiveField::NAME ? "_" : ""), font, 24);
     nameDisplay.setFillColor(sf::Color::White);
     nameDisplay.setPosition(305, 155);
-    window.draw(nameDisplay);
+    draw(nameDisplay);
     
     sf::Text emailDisplay(emailInput + (activeField == ActiveField::EMAIL ? "_" : ""), font, 24);
     emailDisplay.setFillColor(sf::Color::White);
     emailDisplay.setPosition(305, 255);
-    window.draw(emailDisplay);
+    draw(emailDisplay);
     
     sf::Text messageDisplay(messageInput + (activeField == ActiveField::MESSAGE ? "_" : ""), font, 24);
     messageDisplay.setFillColor(sf::Color::White);
     messageDisplay.setPosition(305, 355);
-    window.draw(messageDisplay);
+    draw(messageDisplay);
+    
+    draw(statusText);
     
-    window.draw(statusText);
+    return drawCalls;
 }
 
 void ContactForm::sendFeedback() {
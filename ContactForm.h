@@ -39,8 +39,9 @@ public:
     bool loadFont(const std::string& fontPath);
     void setup(float windowWidth, float windowHeight);
     void handleEvent(const sf::Event& event, const sf::Vector2f& mousePos);
-    void update(const sf::Vector2f& mousePos);
-    void render(sf::RenderWindow& window);
+    bool update(const sf::Vector2f& mousePos);
+    // Возвращает число вызовов draw
+    unsigned int render(sf::RenderTarget& target);
     
     void reset();
     
@@ -1,31 +1,248 @@
 #include "Database.h"
+#include "Log.h"
+#include "Trace.h"
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <ctime>
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+#include <thread>
 #include <sys/stat.h>
 
 namespace fs = std::filesystem;
 
-Database::Database(const std::string& dbPath) : db(nullptr), dbPath(dbPath) {
-    std::cout << "📁 Конструктор Database: " << dbPath << std::endl;
+// Индексы games: миграции 1-2 и ensureIndexes() после прерванной загрузки
+#define GAMES_SCORE_INDEXES_SQL \
+    "CREATE INDEX IF NOT EXISTS idx_games_score ON games (score DESC);" \
+    "CREATE INDEX IF NOT EXISTS idx_games_player_score ON games (player_name, score DESC);" \
+    "CREATE INDEX IF NOT EXISTS idx_games_difficulty_score ON games (difficulty, score DESC);"
+#define GAMES_SEED_INDEX_SQL \
+    "CREATE INDEX IF NOT EXISTS idx_games_seed ON games (seed);"
+// Миграция 6; партии без повтора (в том числе загруженные) в индекс не входят
+#define GAMES_REPLAY_INDEX_SQL \
+    "CREATE INDEX IF NOT EXISTS idx_games_replay ON games (replay) WHERE replay != '';"
+
+// Сводка по игрокам из games: миграция 5 и rebuildPlayerStats()
+#define PLAYER_STATS_FILL_SQL \
+    "INSERT INTO player_stats (player_name, games, best_score, score_sum, score_squares, last_played) " \
+    "SELECT player_name, COUNT(*), MAX(score), SUM(score), SUM(CAST(score AS REAL) * score), MAX(date) " \
+    "FROM games GROUP BY player_name;" \
+    "INSERT INTO player_difficulty_stats (player_name, difficulty, games, best_score) " \
+    "SELECT player_name, difficulty, COUNT(*), MAX(score) FROM games GROUP BY player_name, difficulty;"
+
+namespace {
+    // Текст запросов в порядке Database::Statement
+    const char* const StatementSql[] = {
+        "INSERT INTO games (player_name, score, moves, pairs, time, date, difficulty, seed, theme, replay) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);",
+        "SELECT * FROM games ORDER BY score DESC LIMIT ?;",
+        "SELECT * FROM games WHERE player_name = ? ORDER BY score DESC LIMIT 10;",
+        "SELECT * FROM games WHERE seed = ? ORDER BY id DESC LIMIT 1;",
+        // Условие частичного индекса повторено - иначе SQLite его не выберет
+        "SELECT * FROM games WHERE replay = ? AND replay != '' LIMIT 1;",
+        "INSERT INTO leaderboard (difficulty, theme, score, game_id) VALUES (?, ?, ?, ?);",
+        // Худшая строка таблицы; при равных очках уходит более поздняя партия
+        "DELETE FROM leaderboard WHERE rowid = (SELECT rowid FROM leaderboard "
+        "WHERE difficulty = ? AND theme = ? ORDER BY score ASC, game_id DESC LIMIT 1);",
+        "SELECT g.* FROM leaderboard l JOIN games g ON g.id = l.game_id "
+        "WHERE l.difficulty = ? AND l.theme = ? ORDER BY l.score DESC, l.game_id;",
+        "INSERT INTO player_stats (player_name, games, best_score, score_sum, score_squares, last_played) "
+        "VALUES (?, ?, ?, ?, ?, ?) "
+        "ON CONFLICT (player_name) DO UPDATE SET games = games + excluded.games, "
+        "best_score = max(best_score, excluded.best_score), score_sum = score_sum + excluded.score_sum, "
+        "score_squares = score_squares + excluded.score_squares, last_played = max(last_played, excluded.last_played);",
+        "INSERT INTO player_difficulty_stats (player_name, difficulty, games, best_score) VALUES (?, ?, ?, ?) "
+        "ON CONFLICT (player_name, difficulty) DO UPDATE SET games = games + excluded.games, "
+        "best_score = max(best_score, excluded.best_score);",
+        "SELECT games, best_score, score_sum, score_squares, last_played FROM player_stats WHERE player_name = ?;",
+        "SELECT difficulty, games, best_score FROM player_difficulty_stats WHERE player_name = ? ORDER BY difficulty;"
+    };
+    // Запросы чтения готовятся на отдельном соединении (Database::readDb)
+    const bool StatementReads[] = {
+        false,  // saveGame
+        true,   // getTopScores
+        true,   // getPlayerHistory
+        true,   // findGameBySeed
+        true,   // findGameByReplay
+        false,  // leaderboardInsert
+        false,  // leaderboardTrim
+        true,   // getLeaderboard
+        false,  // playerStatsUpsert
+        false,  // difficultyStatsUpsert
+        true,   // getPlayerStats
+        true    // getDifficultyStats
+    };
+    const char* const StatementNames[] = {
+        "saveGame",
+        "getTopScores",
+        "getPlayerHistory",
+        "findGameBySeed",
+        "findGameByReplay",
+        "leaderboardInsert",
+        "leaderboardTrim",
+        "getLeaderboard",
+        "playerStatsUpsert",
+        "difficultyStatsUpsert",
+        "getPlayerStats",
+        "getDifficultyStats"
+    };
+    
+    // Миграции схемы по порядку: после i-й PRAGMA user_version = i + 1.
+    // Выполненные миграции не меняются - изменения только новыми записями
+    struct Migration {
+        const char* description;
+        const char* sql;
+    };
+    
+    const Migration Migrations[] = {
+        // Таблица лидеров и история игрока читают индекс по порядку
+        // вместо сортировки всей таблицы
+        {"индексы по очкам, игроку и сложности",
+         GAMES_SCORE_INDEXES_SQL},
+        // memory_replay ищет партию по зерну
+        {"индекс по зерну раскладки",
+         GAMES_SEED_INDEX_SQL},
+        {"тема карт в партиях",
+         "ALTER TABLE games ADD COLUMN theme TEXT NOT NULL DEFAULT '';"},
+        // Лучшие Database::LeaderboardSize (10) партий по сложности и теме;
+        // '*' - любая. Дальше таблицы ведёт updateLeaderboards при записи
+        {"таблицы лидеров по сложности и теме",
+         "CREATE TABLE leaderboard ("
+         "difficulty TEXT NOT NULL,"
+         "theme TEXT NOT NULL,"
+         "score INTEGER NOT NULL,"
+         "game_id INTEGER NOT NULL REFERENCES games (id)"
+         ");"
+         "CREATE INDEX idx_leaderboard_board ON leaderboard (difficulty, theme, score DESC, game_id);"
+         "INSERT INTO leaderboard (difficulty, theme, score, game_id) "
+         "SELECT difficulty, theme, score, id FROM ("
+         "SELECT difficulty, theme, score, id, "
+         "ROW_NUMBER() OVER (PARTITION BY difficulty, theme ORDER BY score DESC, id) AS place FROM games "
+         "UNION ALL SELECT difficulty, '*', score, id, "
+         "ROW_NUMBER() OVER (PARTITION BY difficulty ORDER BY score DESC, id) FROM games "
+         "UNION ALL SELECT '*', theme, score, id, "
+         "ROW_NUMBER() OVER (PARTITION BY theme ORDER BY score DESC, id) FROM games "
+         "UNION ALL SELECT '*', '*', score, id, "
+         "ROW_NUMBER() OVER (ORDER BY score DESC, id) FROM games"
+         ") WHERE place <= 10;"},
+        // Сводка по игроку для профиля: ведётся при каждой записи партии
+        {"сводка по игрокам",
+         "CREATE TABLE player_stats ("
+         "player_name TEXT PRIMARY KEY,"
+         "games INTEGER NOT NULL,"
+         "best_score INTEGER NOT NULL,"
+         "score_sum INTEGER NOT NULL,"
+         "score_squares REAL NOT NULL,"
+         "last_played TEXT NOT NULL"
+         ") WITHOUT ROWID;"
+         "CREATE TABLE player_difficulty_stats ("
+         "player_name TEXT NOT NULL,"
+         "difficulty TEXT NOT NULL,"
+         "games INTEGER NOT NULL,"
+         "best_score INTEGER NOT NULL,"
+         "PRIMARY KEY (player_name, difficulty)"
+         ") WITHOUT ROWID;"
+         PLAYER_STATS_FILL_SQL},
+        // Файл повтора партии: с одним зерном (MEMORY_GAME_SEED) бывает
+        // много партий, memory_replay сверяет повтор со своей строкой
+        {"файл повтора в партиях",
+         "ALTER TABLE games ADD COLUMN replay TEXT NOT NULL DEFAULT '';"
+         GAMES_REPLAY_INDEX_SQL}
+    };
+    
+    // Строк в одной транзакции массовой загрузки
+    const std::size_t ImportBatchRows = 100000;
+    const int SchemaVersion = sizeof(Migrations) / sizeof(Migrations[0]);
+    
+    void bindGame(sqlite3_stmt* stmt, const GameRecord& record) {
+        sqlite3_bind_text(stmt, 1, record.playerName.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 2, record.score);
+        sqlite3_bind_int(stmt, 3, record.moves);
+        sqlite3_bind_int(stmt, 4, record.pairs);
+        sqlite3_bind_double(stmt, 5, record.time);
+        sqlite3_bind_text(stmt, 6, record.date.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 7, record.difficulty.c_str(), -1, SQLITE_STATIC);
+        // 64-битное зерно хранится как знаковое целое SQLite
+        sqlite3_bind_int64(stmt, 8, static_cast<sqlite3_int64>(record.seed));
+        sqlite3_bind_text(stmt, 9, record.theme.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 10, record.replay.c_str(), -1, SQLITE_STATIC);
+    }
+    
+    double millisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    // Одно использование подготовленного запроса: на выходе сбрасывает его
+    // и отвязывает параметры (строки привязаны без копирования), время
+    // идёт в счётчики
+    class StatementScope {
+    private:
+        sqlite3_stmt* stmt;
+        StatementStats& stats;
+        std::chrono::steady_clock::time_point start;
+        
+    public:
+        StatementScope(sqlite3_stmt* stmt, StatementStats& stats)
+            : stmt(stmt), stats(stats), start(std::chrono::steady_clock::now()) {
+        }
+        
+        ~StatementScope() {
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+            
+            double ms = millisecondsSince(start);
+            stats.calls++;
+            stats.totalMs += ms;
+            stats.maxMs = std::max(stats.maxMs, ms);
+        }
+        
+        StatementScope(const StatementScope&) = delete;
+        StatementScope& operator=(const StatementScope&) = delete;
+    };
+}
+
+Database::Database(const std::string& dbPath) : db(nullptr), readDb(nullptr), dbPath(dbPath), version(0) {
+    LOG_INFO("📁 Конструктор Database: " << dbPath);
+    for (int i = 0; i < StatementCount; i++) {
+        statements[i] = nullptr;
+        stats[i].name = StatementNames[i];
+    }
 }
 
 Database::~Database() {
+    logStatementStats();
+    // Незавершённые запросы не дают закрыть соединение
+    finalizeStatements();
+    if (readDb) {
+        sqlite3_close(readDb);
+    }
     if (db) {
+        // Обновляет статистику индексов, если она устарела
+        sqlite3_exec(db, "PRAGMA optimize;", nullptr, nullptr, nullptr);
         sqlite3_close(db);
     }
 }
 
 bool Database::initialize() {
+    TRACE_SCOPE("Database::initialize");
     int rc = sqlite3_open(dbPath.c_str(), &db);
     
     if (rc != SQLITE_OK) {
-        std::cerr << "❌ Не удалось открыть БД: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("❌ Не удалось открыть БД: " << sqlite3_errmsg(db));
         return false;
     }
     
-    std::cout << "✅ БД открыта: " << dbPath << std::endl;
+    LOG_INFO("✅ БД открыта: " << dbPath);
+    
+    if (!configureConnection()) {
+        return false;
+    }
     
     // Создаем таблицу
     const char* sql = 
@@ -37,28 +254,199 @@ bool Database::initialize() {
         "pairs INTEGER NOT NULL,"
         "time REAL NOT NULL,"
         "date TEXT NOT NULL,"
-        "difficulty TEXT NOT NULL"
+        "difficulty TEXT NOT NULL,"
+        "seed INTEGER NOT NULL DEFAULT 0"
         ");";
     
     char* errMsg = nullptr;
     rc = sqlite3_exec(db, sql, nullptr, nullptr, &errMsg);
     
     if (rc != SQLITE_OK) {
-        std::cerr << "❌ Ошибка SQL: " << errMsg << std::endl;
+        LOG_ERROR("❌ Ошибка SQL: " << errMsg);
         sqlite3_free(errMsg);
         return false;
     }
     
-    std::cout << "✅ Таблица создана/проверена" << std::endl;
+    // Базы прежних версий создавались без зерна раскладки
+    if (sqlite3_exec(db, "SELECT seed FROM games LIMIT 0;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        if (!executeQuery("ALTER TABLE games ADD COLUMN seed INTEGER NOT NULL DEFAULT 0;")) {
+            return false;
+        }
+        LOG_INFO("✅ Добавлен столбец seed");
+    }
+    
+    LOG_INFO("✅ Таблица создана/проверена");
+    if (!migrate() || !ensureIndexes() || !loadLeaderboardHeaps()) {
+        return false;
+    }
+    openReader();
+    return prepareStatements();
+}
+
+std::string Database::defaultPath() {
+    // В контейнере БД лежит на подключённом томе
+    std::ifstream dockerFile("/.dockerenv");
+    if (dockerFile.good()) {
+        std::error_code error;
+        fs::create_directories("/app/database", error);
+        return "/app/database/memory_game.db";
+    }
+    return "memory_game.db";
+}
+
+bool Database::configureConnection() {
+    // WAL: чтение с readDb (таблица лидеров, профиль) не ждёт фоновую
+    // запись результата на db.
+    // journal_mode хранится в файле БД, остальное - настройки соединения.
+    // Режим журнала нельзя менять внутри транзакции, поэтому он здесь, а не
+    // в миграциях
+    sqlite3_busy_timeout(db, 5000);
+    if (!executeQuery("PRAGMA journal_mode = WAL;")) {
+        LOG_WARN("⚠ WAL недоступен, остаётся журнал отката");
+    }
+    // В WAL synchronous = NORMAL не теряет целостность, только последние
+    // транзакции при отключении питания
+    return executeQuery("PRAGMA synchronous = NORMAL;") &&
+           executeQuery("PRAGMA mmap_size = 67108864;");
+}
+
+void Database::openReader() {
+    // Второе соединение видит тот же файл; у временной БД в памяти оно
+    // было бы пустым - тогда чтение идёт через db под общим замком
+    if (dbPath.empty() || dbPath == ":memory:") {
+        return;
+    }
+    if (sqlite3_open_v2(dbPath.c_str(), &readDb, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        LOG_WARN("⚠ Соединение для чтения не открыто (" << sqlite3_errmsg(readDb) << "), чтение через общее");
+        sqlite3_close(readDb);
+        readDb = nullptr;
+        return;
+    }
+    sqlite3_busy_timeout(readDb, 5000);
+    sqlite3_exec(readDb, "PRAGMA mmap_size = 67108864;", nullptr, nullptr, nullptr);
+}
+
+int Database::readPragma(const std::string& name) {
+    sqlite3_stmt* stmt = nullptr;
+    int value = -1;
+    if (sqlite3_prepare_v2(db, ("PRAGMA " + name + ";").c_str(), -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW) {
+        value = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return value;
+}
+
+int Database::getSchemaVersion() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return db ? readPragma("user_version") : -1;
+}
+
+bool Database::migrate() {
+    TRACE_SCOPE("Database::migrate");
+    int current = readPragma("user_version");
+    if (current < 0) {
+        LOG_ERROR("❌ Не удалось прочитать версию схемы: " << sqlite3_errmsg(db));
+        return false;
+    }
+    if (current > SchemaVersion) {
+        // БД от более новой версии игры: старые запросы к ней ещё подходят
+        LOG_WARN("⚠ Схема БД версии " << current << " новее известной (" << SchemaVersion << ")");
+        return true;
+    }
+    
+    for (int i = current; i < SchemaVersion; i++) {
+        auto start = std::chrono::steady_clock::now();
+        
+        // Миграция и номер версии - одна транзакция: при сбое БД остаётся
+        // на прежней версии и миграция повторится при следующем запуске
+        std::string sql = std::string("BEGIN;") + Migrations[i].sql +
+                          "PRAGMA user_version = " + std::to_string(i + 1) + ";COMMIT;";
+        if (!executeQuery(sql)) {
+            executeQuery("ROLLBACK;");
+            LOG_ERROR("❌ Миграция " << (i + 1) << " (" << Migrations[i].description << ") не выполнена");
+            return false;
+        }
+        
+        LOG_INFO("✅ Миграция " << (i + 1) << ": " << Migrations[i].description
+                 << " (" << std::fixed << std::setprecision(1) << millisecondsSince(start) << " мс)");
+    }
+    
+    return true;
+}
+
+bool Database::ensureIndexes() {
+    // importGames снимает индексы до конца загрузки; если её прервали,
+    // миграции 1-2 и 6 уже не повторятся - восстанавливаем индексы здесь.
+    // Когда индексы на месте, IF NOT EXISTS ничего не делает
+    int schemaVersion = readPragma("user_version");
+    if (schemaVersion < 2) {
+        return true;
+    }
+    auto start = std::chrono::steady_clock::now();
+    int before = countGamesIndexes();
+    std::string sql = GAMES_SCORE_INDEXES_SQL GAMES_SEED_INDEX_SQL;
+    if (schemaVersion >= 6) {
+        sql += GAMES_REPLAY_INDEX_SQL;
+    }
+    if (!executeQuery(sql)) {
+        LOG_ERROR("❌ Не удалось восстановить индексы games");
+        return false;
+    }
+    int restored = countGamesIndexes() - before;
+    if (restored > 0) {
+        LOG_WARN("⚠ Восстановлено индексов games после прерванной загрузки: " << restored
+                 << " (" << std::fixed << std::setprecision(1) << millisecondsSince(start) << " мс)");
+        // Закрытые пачки той загрузки записаны без своей доли сводки
+        if (schemaVersion >= 5) {
+            return rebuildStatsLocked();
+        }
+    }
+    return true;
+}
+
+int Database::countGamesIndexes() {
+    sqlite3_stmt* stmt = nullptr;
+    int count = 0;
+    if (sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM sqlite_master WHERE type = 'index' AND tbl_name = 'games';",
+                           -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW) {
+        count = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return count;
+}
+
+bool Database::prepareStatements() {
+    finalizeStatements();
+    
+    for (int i = 0; i < StatementCount; i++) {
+        auto start = std::chrono::steady_clock::now();
+        sqlite3* connection = StatementReads[i] && readDb ? readDb : db;
+        if (sqlite3_prepare_v3(connection, StatementSql[i], -1, SQLITE_PREPARE_PERSISTENT, &statements[i], nullptr) != SQLITE_OK) {
+            LOG_ERROR("❌ Ошибка подготовки запроса " << StatementNames[i] << ": " << sqlite3_errmsg(connection));
+            finalizeStatements();
+            return false;
+        }
+        stats[i].prepareMs = millisecondsSince(start);
+    }
+    
     return true;
 }
 
+void Database::finalizeStatements() {
+    for (auto& stmt : statements) {
+        sqlite3_finalize(stmt);
+        stmt = nullptr;
+    }
+}
+
 bool Database::executeQuery(const std::string& query) {
     char* errMsg = nullptr;
     int rc = sqlite3_exec(db, query.c_str(), nullptr, nullptr, &errMsg);
     
     if (rc != SQLITE_OK) {
-        std::cerr << "❌ SQL ошибка: " << errMsg << std::endl;
+        LOG_ERROR("❌ SQL ошибка: " << errMsg);
         sqlite3_free(errMsg);
         return false;
     }
@@ -66,123 +454,592 @@ bool Database::executeQuery(const std::string& query) {
     return true;
 }
 
+GameRecord Database::readRecord(sqlite3_stmt* stmt) {
+    // Столбцы в порядке CREATE TABLE (SELECT *)
+    GameRecord record;
+    record.id = sqlite3_column_int(stmt, 0);
+    record.playerName = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+    record.score = sqlite3_column_int(stmt, 2);
+    record.moves = sqlite3_column_int(stmt, 3);
+    record.pairs = sqlite3_column_int(stmt, 4);
+    record.time = sqlite3_column_double(stmt, 5);
+    record.date = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 6));
+    record.difficulty = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 7));
+    record.seed = static_cast<std::uint64_t>(sqlite3_column_int64(stmt, 8));
+    record.theme = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 9));
+    record.replay = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 10));
+    return record;
+}
+
 bool Database::saveGame(const GameRecord& record) {
-    std::string query = "INSERT INTO games (player_name, score, moves, pairs, time, date, difficulty) VALUES (?, ?, ?, ?, ?, ?, ?);";
+    TRACE_SCOPE("Database::saveGame");
+    std::lock_guard<std::mutex> lock(mutex);
+    return commitGames(&record, 1);
+}
+
+bool Database::saveGames(const std::vector<GameRecord>& records, std::vector<bool>& results) {
+    TRACE_SCOPE("Database::saveGames");
+    std::lock_guard<std::mutex> lock(mutex);
+    results.assign(records.size(), false);
+    if (records.empty()) {
+        return true;
+    }
     
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr);
+    // Одна транзакция - один сброс журнала на диск на всю пачку
+    if (commitGames(records.data(), records.size())) {
+        results.assign(records.size(), true);
+        LOG_DEBUG("💾 Пачка из " << records.size() << " результатов сохранена одной транзакцией");
+        return true;
+    }
+    if (records.size() == 1) {
+        return false;
+    }
     
-    if (rc != SQLITE_OK) {
-        std::cerr << "❌ Ошибка подготовки запроса: " << sqlite3_errmsg(db) << std::endl;
+    LOG_WARN("⚠ Транзакция не прошла, результаты сохраняются по одному");
+    bool allSaved = true;
+    for (std::size_t i = 0; i < records.size(); i++) {
+        results[i] = commitGames(&records[i], 1);
+        allSaved = allSaved && results[i];
+    }
+    return allSaved;
+}
+
+bool Database::commitGames(const GameRecord* records, std::size_t count) {
+    if (!statements[INSERT_GAME]) {
+        LOG_ERROR("❌ БД не инициализирована");
+        return false;
+    }
+    if (!executeQuery("BEGIN;")) {
+        return false;
+    }
+    
+    // Партия и таблицы лидеров меняются вместе
+    bool success = true;
+    for (std::size_t i = 0; i < count && success; i++) {
+        success = insertGame(records[i]);
+    }
+    
+    if (success && executeQuery("COMMIT;")) {
+        version += count;
+        return true;
+    }
+    
+    executeQuery("ROLLBACK;");
+    // Кучи уже приняли откаченные очки - перечитываем их с диска
+    loadLeaderboardHeaps();
+    return false;
+}
+
+bool Database::insertGame(const GameRecord& record) {
+    sqlite3_stmt* stmt = statements[INSERT_GAME];
+    StatementScope scope(stmt, stats[INSERT_GAME]);
+    bindGame(stmt, record);
+    
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        LOG_ERROR("❌ Ошибка сохранения: " << sqlite3_errmsg(db));
+        return false;
+    }
+    
+    LOG_DEBUG("💾 Результат сохранен в БД: " << record.playerName 
+              << " - " << record.score << " очков");
+    return updateLeaderboards(record, sqlite3_last_insert_rowid(db)) && updatePlayerStats(record);
+}
+
+void Database::StatsDelta::add(const GameRecord& record) {
+    best = games == 0 ? record.score : std::max(best, record.score);
+    games++;
+    sum += record.score;
+    squares += static_cast<double>(record.score) * record.score;
+    if (record.date > lastPlayed) {
+        lastPlayed = record.date;
+    }
+}
+
+void Database::StatsDelta::merge(const StatsDelta& other) {
+    best = games == 0 ? other.best : std::max(best, other.best);
+    games += other.games;
+    sum += other.sum;
+    squares += other.squares;
+    if (other.lastPlayed > lastPlayed) {
+        lastPlayed = other.lastPlayed;
+    }
+}
+
+bool Database::updatePlayerStats(const GameRecord& record) {
+    StatsDelta delta;
+    delta.add(record);
+    return upsertPlayerStats(record.playerName, delta) &&
+           upsertDifficultyStats(record.playerName, record.difficulty, delta);
+}
+
+bool Database::upsertPlayerStats(const std::string& playerName, const StatsDelta& delta) {
+    sqlite3_stmt* stmt = statements[PLAYER_STATS_UPSERT];
+    StatementScope scope(stmt, stats[PLAYER_STATS_UPSERT]);
+    sqlite3_bind_text(stmt, 1, playerName.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 2, delta.games);
+    sqlite3_bind_int(stmt, 3, delta.best);
+    sqlite3_bind_int64(stmt, 4, delta.sum);
+    sqlite3_bind_double(stmt, 5, delta.squares);
+    sqlite3_bind_text(stmt, 6, delta.lastPlayed.c_str(), -1, SQLITE_STATIC);
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        LOG_ERROR("❌ Ошибка обновления сводки игрока: " << sqlite3_errmsg(db));
+        return false;
+    }
+    return true;
+}
+
+bool Database::upsertDifficultyStats(const std::string& playerName, const std::string& difficulty,
+                                     const StatsDelta& delta) {
+    sqlite3_stmt* stmt = statements[DIFFICULTY_STATS_UPSERT];
+    StatementScope scope(stmt, stats[DIFFICULTY_STATS_UPSERT]);
+    sqlite3_bind_text(stmt, 1, playerName.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, difficulty.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 3, delta.games);
+    sqlite3_bind_int(stmt, 4, delta.best);
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        LOG_ERROR("❌ Ошибка обновления сводки игрока: " << sqlite3_errmsg(db));
+        return false;
+    }
+    return true;
+}
+
+bool Database::getPlayerStats(const std::string& playerName, PlayerStats& result) {
+    TRACE_SCOPE("Database::getPlayerStats");
+    std::lock_guard<std::mutex> lock(readLock());
+    result = PlayerStats();
+    result.playerName = playerName;
+    
+    sqlite3_stmt* stmt = statements[PLAYER_STATS_READ];
+    if (!stmt) {
+        return false;
+    }
+    
+    // Одна строка по ключу и по строке на сложность - без обхода games
+    {
+        StatementScope scope(stmt, stats[PLAYER_STATS_READ]);
+        sqlite3_bind_text(stmt, 1, playerName.c_str(), -1, SQLITE_STATIC);
+        if (sqlite3_step(stmt) != SQLITE_ROW) {
+            return false;
+        }
+        
+        result.games = sqlite3_column_int(stmt, 0);
+        result.bestScore = sqlite3_column_int(stmt, 1);
+        double sum = static_cast<double>(sqlite3_column_int64(stmt, 2));
+        double squares = sqlite3_column_double(stmt, 3);
+        result.lastPlayed = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
+        
+        if (result.games > 0) {
+            result.meanScore = sum / result.games;
+            double variance = squares / result.games - result.meanScore * result.meanScore;
+            result.scoreStdDev = variance > 0.0 ? std::sqrt(variance) : 0.0;
+        }
+    }
+    
+    stmt = statements[DIFFICULTY_STATS_READ];
+    StatementScope scope(stmt, stats[DIFFICULTY_STATS_READ]);
+    sqlite3_bind_text(stmt, 1, playerName.c_str(), -1, SQLITE_STATIC);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        PlayerStats::DifficultyBest best;
+        best.difficulty = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        best.games = sqlite3_column_int(stmt, 1);
+        best.bestScore = sqlite3_column_int(stmt, 2);
+        result.difficulties.push_back(best);
+    }
+    
+    return true;
+}
+
+bool Database::rebuildPlayerStats() {
+    TRACE_SCOPE("Database::rebuildPlayerStats");
+    std::lock_guard<std::mutex> lock(mutex);
+    return db && rebuildStatsLocked();
+}
+
+bool Database::rebuildStatsLocked() {
+    auto start = std::chrono::steady_clock::now();
+    if (!executeQuery("BEGIN;"
+                      "DELETE FROM player_stats;"
+                      "DELETE FROM player_difficulty_stats;"
+                      PLAYER_STATS_FILL_SQL
+                      "COMMIT;")) {
+        executeQuery("ROLLBACK;");
+        return false;
+    }
+    
+    version++;
+    LOG_INFO("✅ Сводка по игрокам пересчитана за " << std::fixed << std::setprecision(1)
+             << millisecondsSince(start) / 1000.0 << " с");
+    return true;
+}
+
+bool Database::updateLeaderboards(const GameRecord& record, sqlite3_int64 gameId) {
+    // Результат попадает в таблицу своей сложности и темы и в сводные
+    const std::pair<std::string, std::string> boards[] = {
+        {record.difficulty, record.theme},
+        {record.difficulty, AnyBoard},
+        {AnyBoard, record.theme},
+        {AnyBoard, AnyBoard}
+    };
+    
+    for (const auto& board : boards) {
+        // Куча хранит очки таблицы, наверху - худшие; если таблица полна и
+        // результат не лучше худшего, диск не трогаем. При равных очках
+        // место остаётся за более ранней партией
+        std::vector<int>& heap = leaderboardHeaps[board];
+        bool full = heap.size() >= static_cast<std::size_t>(LeaderboardSize);
+        if (full && record.score <= heap.front()) {
+            continue;
+        }
+        
+        {
+            sqlite3_stmt* stmt = statements[LEADERBOARD_INSERT];
+            StatementScope scope(stmt, stats[LEADERBOARD_INSERT]);
+            sqlite3_bind_text(stmt, 1, board.first.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(stmt, 2, board.second.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int(stmt, 3, record.score);
+            sqlite3_bind_int64(stmt, 4, gameId);
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
+                LOG_ERROR("❌ Ошибка обновления таблицы лидеров: " << sqlite3_errmsg(db));
+                return false;
+            }
+        }
+        
+        if (full) {
+            sqlite3_stmt* stmt = statements[LEADERBOARD_TRIM];
+            StatementScope scope(stmt, stats[LEADERBOARD_TRIM]);
+            sqlite3_bind_text(stmt, 1, board.first.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(stmt, 2, board.second.c_str(), -1, SQLITE_STATIC);
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
+                LOG_ERROR("❌ Ошибка обновления таблицы лидеров: " << sqlite3_errmsg(db));
+                return false;
+            }
+            std::pop_heap(heap.begin(), heap.end(), std::greater<int>());
+            heap.pop_back();
+        }
+        
+        heap.push_back(record.score);
+        std::push_heap(heap.begin(), heap.end(), std::greater<int>());
+    }
+    
+    return true;
+}
+
+bool Database::loadLeaderboardHeaps() {
+    leaderboardHeaps.clear();
+    
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT difficulty, theme, score FROM leaderboard;", -1, &stmt, nullptr) != SQLITE_OK) {
+        LOG_ERROR("❌ Не удалось прочитать таблицы лидеров: " << sqlite3_errmsg(db));
+        return false;
+    }
+    
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        std::pair<std::string, std::string> board(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+                                                  reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)));
+        std::vector<int>& heap = leaderboardHeaps[board];
+        heap.push_back(sqlite3_column_int(stmt, 2));
+        std::push_heap(heap.begin(), heap.end(), std::greater<int>());
+    }
+    sqlite3_finalize(stmt);
+    
+    LOG_DEBUG("🏆 Таблиц лидеров в памяти: " << leaderboardHeaps.size());
+    return true;
+}
+
+bool Database::forEachGame(const std::function<bool(const GameRecord&)>& visit) {
+    TRACE_SCOPE("Database::forEachGame");
+    std::lock_guard<std::mutex> lock(readLock());
+    
+    // Строки читаются по одной - память не зависит от размера таблицы.
+    // Выгрузка идёт со снимка readDb и не мешает записи
+    sqlite3* connection = readDb ? readDb : db;
+    sqlite3_stmt* stmt = nullptr;
+    if (!connection || sqlite3_prepare_v2(connection, "SELECT * FROM games ORDER BY id;", -1, &stmt, nullptr) != SQLITE_OK) {
+        LOG_ERROR("❌ Не удалось прочитать партии: " << (connection ? sqlite3_errmsg(connection) : "БД не открыта"));
+        return false;
+    }
+    
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        if (!visit(readRecord(stmt))) {
+            rc = SQLITE_DONE;
+            break;
+        }
+    }
+    sqlite3_finalize(stmt);
+    
+    if (rc != SQLITE_DONE) {
+        LOG_ERROR("❌ Ошибка чтения партий: " << sqlite3_errmsg(connection));
+        return false;
+    }
+    return true;
+}
+
+bool Database::importGames(const std::function<bool(GameRecord&)>& next, std::size_t& imported) {
+    TRACE_SCOPE("Database::importGames");
+    std::lock_guard<std::mutex> lock(mutex);
+    imported = 0;
+    
+    sqlite3_stmt* insert = statements[INSERT_GAME];
+    if (!insert) {
+        LOG_ERROR("❌ БД не инициализирована");
         return false;
     }
     
-    // Привязываем параметры
-    sqlite3_bind_text(stmt, 1, record.playerName.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 2, record.score);
-    sqlite3_bind_int(stmt, 3, record.moves);
-    sqlite3_bind_int(stmt, 4, record.pairs);
-    sqlite3_bind_double(stmt, 5, record.time);
-    sqlite3_bind_text(stmt, 6, record.date.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 7, record.difficulty.c_str(), -1, SQLITE_STATIC);
+    // Индексы games снимаются на время загрузки и строятся заново одной
+    // сортировкой - это быстрее, чем обновлять их на каждой строке.
+    // Таблицы лидеров ведутся по ходу загрузки, как при обычной записи.
+    // Текст берётся из sqlite_master, так что список следует за миграциями
+    // Если загрузку прервут, индексы вернёт ensureIndexes() при следующем открытии
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::pair<std::string, std::string>> indexes;
+    {
+        sqlite3_stmt* stmt = nullptr;
+        sqlite3_prepare_v2(db, "SELECT name, sql FROM sqlite_master "
+                               "WHERE type = 'index' AND tbl_name = 'games' AND sql IS NOT NULL;",
+                           -1, &stmt, nullptr);
+        while (stmt && sqlite3_step(stmt) == SQLITE_ROW) {
+            indexes.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+                                 reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)));
+        }
+        sqlite3_finalize(stmt);
+    }
+    for (const auto& index : indexes) {
+        executeQuery("DROP INDEX IF EXISTS " + index.first + ";");
+    }
+    
+    // На многоядерной машине SQLite сортирует для индексов в нескольких потоках
+    unsigned int sortThreads = std::min(4u, std::max(1u, std::thread::hardware_concurrency()) - 1);
+    executeQuery("PRAGMA threads = " + std::to_string(sortThreads) + ";");
     
-    rc = sqlite3_step(stmt);
+    std::unordered_map<std::string, StatsDelta> difficultyDeltas;  // игрок, '\0', сложность
+    std::string difficultyKey;
     
-    bool success = (rc == SQLITE_DONE);
+    // Крупные транзакции: один сброс журнала на ImportBatchRows строк
+    bool success = executeQuery("BEGIN;");
+    std::size_t inBatch = 0;
+    GameRecord record;
+    while (success && next(record)) {
+        {
+            StatementScope scope(insert, stats[INSERT_GAME]);
+            bindGame(insert, record);
+            if (sqlite3_step(insert) != SQLITE_DONE) {
+                LOG_ERROR("❌ Ошибка загрузки: " << sqlite3_errmsg(db));
+                success = false;
+                break;
+            }
+        }
+        // Кучи отсеивают почти все строки - на диск попадают только
+        // результаты, входящие в таблицы лидеров
+        if (!updateLeaderboards(record, sqlite3_last_insert_rowid(db))) {
+            success = false;
+            break;
+        }
+        // Сводка копится в памяти (размер - число игроков, не партий)
+        // и записывается один раз в конце
+        difficultyKey.assign(record.playerName).append(1, '\0').append(record.difficulty);
+        difficultyDeltas[difficultyKey].add(record);
+        
+        if (++inBatch == ImportBatchRows) {
+            if (!executeQuery("COMMIT;")) {
+                success = false;
+                break;
+            }
+            imported += inBatch;
+            inBatch = 0;
+            if (!executeQuery("BEGIN;")) {
+                LOG_ERROR("❌ Не удалось начать следующую пачку загрузки");
+                success = false;
+                break;
+            }
+        }
+    }
     
     if (success) {
-        std::cout << "💾 Результат сохранен в БД: " << record.playerName 
-                  << " - " << record.score << " очков" << std::endl;
+        // Итог игрока - сумма его сложностей
+        std::unordered_map<std::string, StatsDelta> playerDeltas;
+        for (const auto& delta : difficultyDeltas) {
+            std::size_t split = delta.first.find('\0');
+            std::string playerName = delta.first.substr(0, split);
+            success = success && upsertDifficultyStats(playerName, delta.first.substr(split + 1), delta.second);
+            playerDeltas[playerName].merge(delta.second);
+        }
+        for (const auto& delta : playerDeltas) {
+            success = success && upsertPlayerStats(delta.first, delta.second);
+        }
+    }
+    
+    if (success && executeQuery("COMMIT;")) {
+        imported += inBatch;
     } else {
-        std::cerr << "❌ Ошибка сохранения: " << sqlite3_errmsg(db) << std::endl;
+        // Теряется только незакрытая пачка - прежние уже записаны.
+        // Кучи могли принять откаченные строки. После неудачного BEGIN
+        // откатывать нечего
+        if (!sqlite3_get_autocommit(db)) {
+            executeQuery("ROLLBACK;");
+        }
+        loadLeaderboardHeaps();
+        success = false;
     }
+    double rowsMs = millisecondsSince(start);
     
-    sqlite3_finalize(stmt);
+    for (const auto& index : indexes) {
+        success = executeQuery(index.second + ";") && success;
+    }
     
+    // Закрытые пачки записаны без своей доли сводки - считаем её заново
+    if (!success && imported > 0) {
+        rebuildStatsLocked();
+    }
+    
+    LOG_INFO("📥 Загружено " << imported << " партий: строки " << std::fixed << std::setprecision(1)
+             << rowsMs / 1000.0 << " с, индексы " << (millisecondsSince(start) - rowsMs) / 1000.0 << " с");
+    version += imported;
     return success;
 }
 
-std::vector<GameRecord> Database::getTopScores(int limit) {
+std::vector<GameRecord> Database::getLeaderboard(const std::string& difficulty, const std::string& theme) {
+    TRACE_SCOPE("Database::getLeaderboard");
+    std::lock_guard<std::mutex> lock(readLock());
     std::vector<GameRecord> records;
     
-    std::string query = "SELECT * FROM games ORDER BY score DESC LIMIT " + std::to_string(limit) + ";";
+    sqlite3_stmt* stmt = statements[LEADERBOARD_READ];
+    if (!stmt) {
+        return records;
+    }
+    StatementScope scope(stmt, stats[LEADERBOARD_READ]);
     
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr);
+    sqlite3_bind_text(stmt, 1, difficulty.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, theme.c_str(), -1, SQLITE_STATIC);
     
-    if (rc != SQLITE_OK) {
-        std::cerr << "❌ Ошибка подготовки запроса: " << sqlite3_errmsg(db) << std::endl;
+    // Не больше LeaderboardSize строк при любом размере games
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        records.push_back(readRecord(stmt));
+    }
+    
+    return records;
+}
+
+std::vector<GameRecord> Database::getTopScores(int limit) {
+    TRACE_SCOPE("Database::getTopScores");
+    std::lock_guard<std::mutex> lock(readLock());
+    std::vector<GameRecord> records;
+    
+    sqlite3_stmt* stmt = statements[TOP_SCORES];
+    if (!stmt) {
         return records;
     }
+    StatementScope scope(stmt, stats[TOP_SCORES]);
+    
+    sqlite3_bind_int(stmt, 1, limit);
     
     while (sqlite3_step(stmt) == SQLITE_ROW) {
-        GameRecord record;
-        record.id = sqlite3_column_int(stmt, 0);
-        record.playerName = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-        record.score = sqlite3_column_int(stmt, 2);
-        record.moves = sqlite3_column_int(stmt, 3);
-        record.pairs = sqlite3_column_int(stmt, 4);
-        record.time = sqlite3_column_double(stmt, 5);
-        record.date = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 6));
-        record.difficulty = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 7));
-        
-        records.push_back(record);
+        records.push_back(readRecord(stmt));
     }
     
-    sqlite3_finalize(stmt);
     return records;
 }
 
 void Database::displayLeaderboard() {
     auto records = getTopScores(10);
+    std::stringstream table;
     
-    std::cout << "\n╔════════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║                    🏆 ТАБЛИЦА ЛИДЕРОВ 🏆                      ║\n";
-    std::cout << "╠════╦═══════════════╦═══════╦═══════╦═══════╦═════════════════╣\n";
-    std::cout << "║ №  ║ Игрок         ║ Очки  ║ Ходы  ║ Время ║ Сложность       ║\n";
-    std::cout << "╠════╬═══════════════╬═══════╬═══════╬═══════╬═════════════════╣\n";
+    table << "\n╔════════════════════════════════════════════════════════════════╗\n";
+    table << "║                    🏆 ТАБЛИЦА ЛИДЕРОВ 🏆                      ║\n";
+    table << "╠════╦═══════════════╦═══════╦═══════╦═══════╦═════════════════╣\n";
+    table << "║ №  ║ Игрок         ║ Очки  ║ Ходы  ║ Время ║ Сложность       ║\n";
+    table << "╠════╬═══════════════╬═══════╬═══════╬═══════╬═════════════════╣\n";
     
     for (size_t i = 0; i < records.size(); i++) {
-        std::cout << "║ " << std::setw(2) << (i + 1) << " ║ "
-                  << std::setw(13) << std::left << records[i].playerName.substr(0, 13) << " ║ "
-                  << std::setw(5) << std::right << records[i].score << " ║ "
-                  << std::setw(5) << records[i].moves << " ║ "
-                  << std::setw(5) << (int)records[i].time << " ║ "
-                  << std::setw(15) << std::left << records[i].difficulty << " ║\n";
+        table << "║ " << std::setw(2) << (i + 1) << " ║ "
+              << std::setw(13) << std::left << records[i].playerName.substr(0, 13) << " ║ "
+              << std::setw(5) << std::right << records[i].score << " ║ "
+              << std::setw(5) << records[i].moves << " ║ "
+              << std::setw(5) << (int)records[i].time << " ║ "
+              << std::setw(15) << std::left << records[i].difficulty << " ║\n";
     }
     
-    std::cout << "╚════╩═══════════════╩═══════╩═══════╩═══════╩═════════════════╝\n";
+    table << "╚════╩═══════════════╩═══════╩═══════╩═══════╩═════════════════╝";
+    LOG_INFO(table.str());
 }
 
 std::vector<GameRecord> Database::getPlayerHistory(const std::string& playerName) {
+    std::lock_guard<std::mutex> lock(readLock());
     std::vector<GameRecord> records;
     
-    std::string query = "SELECT * FROM games WHERE player_name = ? ORDER BY score DESC LIMIT 10;";
-    
-    sqlite3_stmt* stmt;
-    int rc = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr);
-    
-    if (rc != SQLITE_OK) {
-        std::cerr << "❌ Ошибка подготовки запроса: " << sqlite3_errmsg(db) << std::endl;
+    sqlite3_stmt* stmt = statements[PLAYER_HISTORY];
+    if (!stmt) {
         return records;
     }
+    StatementScope scope(stmt, stats[PLAYER_HISTORY]);
     
     sqlite3_bind_text(stmt, 1, playerName.c_str(), -1, SQLITE_STATIC);
     
     while (sqlite3_step(stmt) == SQLITE_ROW) {
-        GameRecord record;
-        record.id = sqlite3_column_int(stmt, 0);
-        record.playerName = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-        record.score = sqlite3_column_int(stmt, 2);
-        record.moves = sqlite3_column_int(stmt, 3);
-        record.pairs = sqlite3_column_int(stmt, 4);
-        record.time = sqlite3_column_double(stmt, 5);
-        record.date = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 6));
-        record.difficulty = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 7));
-        
-        records.push_back(record);
+        records.push_back(readRecord(stmt));
     }
     
-    sqlite3_finalize(stmt);
     return records;
 }
+
+bool Database::findGameBySeed(std::uint64_t seed, GameRecord& record) {
+    std::lock_guard<std::mutex> lock(readLock());
+    sqlite3_stmt* stmt = statements[GAME_BY_SEED];
+    if (!stmt) {
+        return false;
+    }
+    StatementScope scope(stmt, stats[GAME_BY_SEED]);
+    
+    sqlite3_bind_int64(stmt, 1, static_cast<sqlite3_int64>(seed));
+    
+    bool found = sqlite3_step(stmt) == SQLITE_ROW;
+    if (found) {
+        record = readRecord(stmt);
+    }
+    
+    return found;
+}
+
+bool Database::findGameByReplay(const std::string& replay, GameRecord& record) {
+    std::lock_guard<std::mutex> lock(readLock());
+    sqlite3_stmt* stmt = statements[GAME_BY_REPLAY];
+    if (!stmt || replay.empty()) {
+        return false;
+    }
+    StatementScope scope(stmt, stats[GAME_BY_REPLAY]);
+    
+    sqlite3_bind_text(stmt, 1, replay.c_str(), -1, SQLITE_STATIC);
+    
+    bool found = sqlite3_step(stmt) == SQLITE_ROW;
+    if (found) {
+        record = readRecord(stmt);
+    }
+    
+    return found;
+}
+
+std::vector<StatementStats> Database::getStatementStats() const {
+    std::scoped_lock lock(mutex, readMutex);
+    return std::vector<StatementStats>(stats, stats + StatementCount);
+}
+
+void Database::logStatementStats() const {
+    std::scoped_lock lock(mutex, readMutex);
+    std::stringstream table;
+    table << std::fixed << std::setprecision(3) << "📊 Запросы БД (вызовов, среднее/макс. мс, подготовка мс):";
+    
+    bool any = false;
+    for (const auto& stat : stats) {
+        if (stat.calls == 0) {
+            continue;
+        }
+        table << "\n  " << std::setw(18) << std::left << stat.name << std::right
+              << std::setw(8) << stat.calls << std::setw(10) << stat.totalMs / stat.calls
+              << std::setw(10) << stat.maxMs << std::setw(10) << stat.prepareMs;
+        any = true;
+    }
+    
+    if (any) {
+        LOG_INFO(table.str());
+    }
+}
@@ -1,6 +1,11 @@
 #ifndef DATABASE_H
 #define DATABASE_H
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <sqlite3.h>
@@ -14,24 +19,146 @@ struct GameRecord {
     double time;
     std::string date;
     std::string difficulty;
+    std::uint64_t seed = 0;  // зерно раскладки
+    std::string theme;       // тема карт; пусто у партий до появления столбца
+    std::string replay;      // имя файла повтора в replays/; пусто - повтора нет
+};
+
+// Счётчики одного подготовленного запроса
+struct StatementStats {
+    const char* name = "";
+    unsigned long calls = 0;
+    double totalMs = 0.0;    // reset, bind, step и чтение строк
+    double maxMs = 0.0;
+    double prepareMs = 0.0;  // однократная подготовка - столько стоил бы каждый вызов сверху
+};
+
+// Сводка по игроку для профиля (таблицы player_stats и player_difficulty_stats)
+struct PlayerStats {
+    struct DifficultyBest {
+        std::string difficulty;
+        int games = 0;
+        int bestScore = 0;
+    };
+    
+    std::string playerName;
+    int games = 0;
+    int bestScore = 0;
+    double meanScore = 0.0;
+    double scoreStdDev = 0.0;
+    std::string lastPlayed;
+    std::vector<DifficultyBest> difficulties;
 };
 
 class Database {
 private:
+    // Запросы готовятся один раз в initialize(), дальше только reset и bind
+    enum Statement {
+        INSERT_GAME,
+        TOP_SCORES,
+        PLAYER_HISTORY,
+        GAME_BY_SEED,
+        GAME_BY_REPLAY,
+        LEADERBOARD_INSERT,
+        LEADERBOARD_TRIM,
+        LEADERBOARD_READ,
+        PLAYER_STATS_UPSERT,
+        DIFFICULTY_STATS_UPSERT,
+        PLAYER_STATS_READ,
+        DIFFICULTY_STATS_READ,
+        StatementCount
+    };
+    
     sqlite3* db;
+    sqlite3* readDb;  // только чтение для главного потока; nullptr - читаем через db
     std::string dbPath;
+    std::atomic<unsigned long> version;  // растёт при каждой записи результата
+    sqlite3_stmt* statements[StatementCount];
+    StatementStats stats[StatementCount];
+    // mutex - соединение db и его запросы: запись (PersistenceWorker,
+    // загрузка), миграции. readMutex - соединение readDb и запросы чтения.
+    // В WAL чтение не ждёт транзакцию записи на другом соединении
+    mutable std::mutex mutex;
+    mutable std::mutex readMutex;
+    // Очки каждой таблицы лидеров (сложность, тема) - куча с худшим наверху.
+    // Зеркало таблицы leaderboard: по нему слабый результат отсеивается без диска
+    std::map<std::pair<std::string, std::string>, std::vector<int>> leaderboardHeaps;
+    
+    bool configureConnection();
+    void openReader();
+    std::mutex& readLock() const { return readDb ? readMutex : mutex; }
+    bool migrate();
+    bool ensureIndexes();
+    int countGamesIndexes();
+    int readPragma(const std::string& name);
+    bool prepareStatements();
+    bool commitGames(const GameRecord* records, std::size_t count);
+    bool insertGame(const GameRecord& record);
+    bool updateLeaderboards(const GameRecord& record, sqlite3_int64 gameId);
+    bool loadLeaderboardHeaps();
+    // Прирост сводки игрока: одна партия или все партии игрока из загрузки
+    struct StatsDelta {
+        long long games = 0;
+        int best = 0;
+        long long sum = 0;
+        double squares = 0.0;
+        std::string lastPlayed;
+        
+        void add(const GameRecord& record);
+        void merge(const StatsDelta& other);
+    };
     
+    bool updatePlayerStats(const GameRecord& record);
+    bool upsertPlayerStats(const std::string& playerName, const StatsDelta& delta);
+    bool upsertDifficultyStats(const std::string& playerName, const std::string& difficulty,
+                               const StatsDelta& delta);
+    bool rebuildStatsLocked();
+    void finalizeStatements();
     bool executeQuery(const std::string& query);
+    static GameRecord readRecord(sqlite3_stmt* stmt);
 
 public:
+    // Размер каждой таблицы лидеров; '*' вместо сложности или темы - любая
+    static constexpr int LeaderboardSize = 10;
+    static constexpr const char* AnyBoard = "*";
+    
     Database(const std::string& dbPath = "memory_game.db");
     ~Database();
     
+    // memory_game.db рядом с игрой или на томе /app/database в Docker
+    static std::string defaultPath();
+    
     bool initialize();
+    // Версия схемы (PRAGMA user_version) после initialize()
+    int getSchemaVersion();
     bool saveGame(const GameRecord& record);
+    // Все записи одной транзакцией; если она не прошла - по одной.
+    // results[i] - сохранена ли records[i]; true, если сохранены все
+    bool saveGames(const std::vector<GameRecord>& records, std::vector<bool>& results);
     std::vector<GameRecord> getTopScores(int limit = 10);
     std::vector<GameRecord> getPlayerHistory(const std::string& playerName);
+    // Таблица лидеров по сложности и теме (AnyBoard - все): не больше
+    // LeaderboardSize строк, время не зависит от числа партий
+    std::vector<GameRecord> getLeaderboard(const std::string& difficulty, const std::string& theme);
+    // Последняя партия с зерном - для повторов, записанных до столбца replay
+    bool findGameBySeed(std::uint64_t seed, GameRecord& record);
+    // Партия, записавшая файл повтора (имя без папки)
+    bool findGameByReplay(const std::string& replay, GameRecord& record);
+    // Сводка по игроку - чтение по ключу, без обхода партий; false, если
+    // у игрока нет записанных партий
+    bool getPlayerStats(const std::string& playerName, PlayerStats& result);
+    // Пересчёт сводки по всем партиям (memory_game --rebuild-stats)
+    bool rebuildPlayerStats();
+    // Все партии по порядку id, по одной строке; visit возвращает false,
+    // чтобы остановиться
+    bool forEachGame(const std::function<bool(const GameRecord&)>& visit);
+    // Массовая загрузка: next заполняет запись и возвращает false в конце.
+    // Индексы и таблицы лидеров перестраиваются после загрузки
+    bool importGames(const std::function<bool(GameRecord&)>& next, std::size_t& imported);
     void displayLeaderboard();
+    unsigned long getVersion() const { return version.load(); }
+    std::vector<StatementStats> getStatementStats() const;
+    void logStatementStats() const;
     
     // Метод для совместимости с Game.cpp
     std::vector<GameRecord> getTopPlayers(int limit = 10) {
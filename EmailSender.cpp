@@ -1,4 +1,5 @@
 #include "EmailSender.h"
+#include "Log.h"
 #include <iostream>
 #include <fstream>
 #include <ctime>
@@ -37,7 +38,7 @@ bool EmailSender::sendFeedback(const std::string& userName,
         // Сохраняем в файл
         std::ofstream file(filepath);
         if (!file.is_open()) {
-            std::cerr << "❌ Ошибка создания файла: " << filepath << std::endl;
+            LOG_ERROR("❌ Ошибка создания файла: " << filepath);
             return false;
         }
         
@@ -60,16 +61,16 @@ bool EmailSender::sendFeedback(const std::string& userName,
             logfile.close();
         }
         
-        std::cout << "\n✅ Обращение сохранено!\n";
-        std::cout << "📁 Файл: " << filepath << "\n";
-        std::cout << "👤 От: " << userName << "\n";
-        std::cout << "📧 Email: " << userEmail << "\n";
-        std::cout << "💬 Длина сообщения: " << message.length() << " символов\n";
+        LOG_INFO("✅ Обращение сохранено!\n"
+                 << "📁 Файл: " << filepath << "\n"
+                 << "👤 От: " << userName << "\n"
+                 << "📧 Email: " << userEmail << "\n"
+                 << "💬 Длина сообщения: " << message.length() << " символов");
         
         return true;
         
     } catch (const std::exception& e) {
-        std::cerr << "❌ Ошибка при сохранении обращения: " << e.what() << std::endl;
+        LOG_ERROR("❌ Ошибка при сохранении обращения: " << e.what());
         return false;
     }
 }
@@ -0,0 +1,115 @@
+#include "EventScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <climits>
+
+EventScheduler::EventScheduler(float tickSeconds)
+    : tickSeconds(tickSeconds), accumulator(0.0f), currentTick(0),
+      nextId(1), generation(0), slots(SlotCount) {
+}
+
+EventScheduler::TimerId EventScheduler::schedule(float delaySeconds, Callback callback) {
+    // Не раньше следующего тика, чтобы действие не сработало в том же кадре
+    unsigned long ticks = static_cast<unsigned long>(std::ceil(std::max(0.0f, delaySeconds) / tickSeconds));
+    ticks = std::max(1ul, ticks);
+
+    Timer timer;
+    timer.id = nextId++;
+    timer.deadlineTick = currentTick + ticks;
+    timer.callback = std::move(callback);
+
+    std::size_t slot = timer.deadlineTick % SlotCount;
+    slotOf[timer.id] = slot;
+    slots[slot].push_back(std::move(timer));
+
+    return nextId - 1;
+}
+
+bool EventScheduler::cancel(TimerId id) {
+    auto it = slotOf.find(id);
+    if (it != slotOf.end()) {
+        auto& slot = slots[it->second];
+        slot.erase(std::remove_if(slot.begin(), slot.end(),
+                                  [id](const Timer& timer) { return timer.id == id; }),
+                   slot.end());
+        slotOf.erase(it);
+        return true;
+    }
+
+    // Таймер уже снят с колеса и ждёт вызова в текущей пачке
+    for (auto& timer : firing) {
+        if (timer.id == id && timer.callback) {
+            timer.callback = nullptr;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void EventScheduler::clear() {
+    for (auto& slot : slots) {
+        slot.clear();
+    }
+    slotOf.clear();
+    firing.clear();
+    accumulator = 0.0f;
+    generation++;
+}
+
+float EventScheduler::getTimeUntilNext() const {
+    if (slotOf.empty()) {
+        return -1.0f;
+    }
+
+    unsigned long nearest = ULONG_MAX;
+    for (const auto& slot : slots) {
+        for (const auto& timer : slot) {
+            nearest = std::min(nearest, timer.deadlineTick);
+        }
+    }
+
+    return std::max(0.0f, (nearest - currentTick) * tickSeconds - accumulator);
+}
+
+void EventScheduler::update(float deltaTime) {
+    accumulator += deltaTime;
+
+    while (accumulator >= tickSeconds) {
+        accumulator -= tickSeconds;
+        advanceTick();
+    }
+}
+
+void EventScheduler::advanceTick() {
+    currentTick++;
+
+    auto& slot = slots[currentTick % SlotCount];
+    if (slot.empty()) {
+        return;
+    }
+
+    // Таймеры с дедлайном на следующих оборотах колеса остаются в слоте
+    auto due = std::stable_partition(slot.begin(), slot.end(),
+                                     [this](const Timer& timer) { return timer.deadlineTick > currentTick; });
+
+    firing.clear();
+    for (auto it = due; it != slot.end(); ++it) {
+        slotOf.erase(it->id);
+        firing.push_back(std::move(*it));
+    }
+    slot.erase(due, slot.end());
+
+    // Обратные вызовы могут ставить новые таймеры или сбрасывать планировщик
+    unsigned long startGeneration = generation;
+    for (std::size_t i = 0; i < firing.size() && generation == startGeneration; i++) {
+        Callback callback = std::move(firing[i].callback);
+        if (callback) {
+            callback();
+        }
+    }
+
+    if (generation == startGeneration) {
+        firing.clear();
+    }
+}
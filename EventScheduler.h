@@ -0,0 +1,51 @@
+#ifndef EVENTSCHEDULER_H
+#define EVENTSCHEDULER_H
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Отложенные действия на колесе таймеров.
+// Время идёт только через update(), поэтому таймеры стоят на паузе вместе
+// с игрой. Постановка и отмена - O(1), тик проверяет один слот колеса.
+class EventScheduler {
+public:
+    typedef unsigned long TimerId;
+    typedef std::function<void()> Callback;
+
+private:
+    struct Timer {
+        TimerId id;
+        unsigned long deadlineTick;
+        Callback callback;
+    };
+
+    static const std::size_t SlotCount = 256;
+
+    float tickSeconds;
+    float accumulator;
+    unsigned long currentTick;
+    TimerId nextId;
+    unsigned long generation;  // меняется в clear(), чтобы прервать текущую пачку
+
+    std::vector<std::vector<Timer>> slots;
+    std::unordered_map<TimerId, std::size_t> slotOf;
+    std::vector<Timer> firing;
+
+    void advanceTick();
+
+public:
+    explicit EventScheduler(float tickSeconds = 0.01f);
+
+    TimerId schedule(float delaySeconds, Callback callback);
+    bool cancel(TimerId id);
+    void clear();
+    void update(float deltaTime);
+
+    // Секунды до ближайшего таймера; -1, если таймеров нет
+    float getTimeUntilNext() const;
+    bool hasPending() const { return !slotOf.empty(); }
+    std::size_t getPendingCount() const { return slotOf.size(); }
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "FrameTiming.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+FrameTiming::FrameTiming()
+    : samples(HistorySize), next(0), count(0) {
+}
+
+void FrameTiming::record(const FrameSample& sample) {
+    samples[next] = sample;
+    next = (next + 1) % HistorySize;
+    count = std::min(count + 1, HistorySize);
+}
+
+void FrameTiming::clear() {
+    next = 0;
+    count = 0;
+}
+
+const FrameSample& FrameTiming::getLast() const {
+    return samples[(next + HistorySize - 1) % HistorySize];
+}
+
+const FrameSample& FrameTiming::getSample(std::size_t age) const {
+    return samples[(next + HistorySize - count + age) % HistorySize];
+}
+
+FrameSample FrameTiming::getAverage() const {
+    FrameSample average;
+    if (count == 0) {
+        return average;
+    }
+
+    int ticks = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        average.eventsMs += samples[i].eventsMs;
+        average.updateMs += samples[i].updateMs;
+        average.renderMs += samples[i].renderMs;
+        average.presentMs += samples[i].presentMs;
+        average.frameMs += samples[i].frameMs;
+        ticks += samples[i].ticks;
+    }
+
+    average.eventsMs /= count;
+    average.updateMs /= count;
+    average.renderMs /= count;
+    average.presentMs /= count;
+    average.frameMs /= count;
+    average.ticks = static_cast<int>(std::lround(static_cast<double>(ticks) / count));
+    return average;
+}
+
+float FrameTiming::getPercentile(FramePhase phase, float p) const {
+    if (count == 0) {
+        return 0.0f;
+    }
+
+    std::vector<float> values;
+    values.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        values.push_back(getPhaseMs(samples[i], phase));
+    }
+
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0f * count));
+    std::size_t index = std::min(count - 1, rank > 0 ? rank - 1 : 0);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+float FrameTiming::getHeadroomMs(float budgetMs) const {
+    FrameSample average = getAverage();
+    return budgetMs - average.updateMs - average.renderMs;
+}
+
+bool FrameTiming::writeCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    out << "frame,events_ms,update_ms,render_ms,present_ms,frame_ms,ticks\n";
+    for (std::size_t i = 0; i < count; i++) {
+        const FrameSample& sample = getSample(i);
+        out << i << ',' << sample.eventsMs << ',' << sample.updateMs << ',' << sample.renderMs << ','
+            << sample.presentMs << ',' << sample.frameMs << ',' << sample.ticks << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+float FrameTiming::getPhaseMs(const FrameSample& sample, FramePhase phase) {
+    switch (phase) {
+        case FramePhase::EVENTS: return sample.eventsMs;
+        case FramePhase::UPDATE: return sample.updateMs;
+        case FramePhase::RENDER: return sample.renderMs;
+        case FramePhase::PRESENT: return sample.presentMs;
+        case FramePhase::FRAME: return sample.frameMs;
+    }
+    return 0.0f;
+}
@@ -0,0 +1,59 @@
+#ifndef FRAMETIMING_H
+#define FRAMETIMING_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Время последних кадров по фазам.
+// Хранит кольцо из HistorySize кадров; по нему видно, сколько кадра
+// уходит на логику, сборку и показ и какой остаётся запас до бюджета.
+struct FrameSample {
+    float eventsMs = 0.0f;   // handleEvents
+    float updateMs = 0.0f;   // все тики логики за кадр
+    float renderMs = 0.0f;   // сборка кадра (renderFrame)
+    float presentMs = 0.0f;  // display(): ожидание vsync/драйвера
+    float frameMs = 0.0f;    // от начала прошлого кадра до начала этого
+    int ticks = 0;
+};
+
+enum class FramePhase {
+    EVENTS,
+    UPDATE,
+    RENDER,
+    PRESENT,
+    FRAME
+};
+
+class FrameTiming {
+public:
+    static constexpr std::size_t HistorySize = 240;
+
+private:
+    std::vector<FrameSample> samples;
+    std::size_t next;
+    std::size_t count;
+
+public:
+    FrameTiming();
+
+    void record(const FrameSample& sample);
+    void clear();
+
+    std::size_t getCount() const { return count; }
+    const FrameSample& getLast() const;
+    // age = 0 - самый старый из хранимых кадров
+    const FrameSample& getSample(std::size_t age) const;
+    FrameSample getAverage() const;
+    // Перцентиль времени фазы, p от 0 до 100
+    float getPercentile(FramePhase phase, float p) const;
+    float getFramePercentile(float p) const { return getPercentile(FramePhase::FRAME, p); }
+    // Бюджет кадра минус среднее время логики и сборки
+    float getHeadroomMs(float budgetMs) const;
+    // История от старых кадров к новым, по строке на кадр
+    bool writeCsv(const std::string& path) const;
+
+    static float getPhaseMs(const FrameSample& sample, FramePhase phase);
+};
+
+#endif
@@ -1,4 +1,6 @@
 #include "Game.h"
+#include "Log.h"
+#include "Trace.h"
 #include <iostream>
 #include <algorithm>
 #include <random>
@@ -11,6 +13,11 @@
 #include <filesystem>
 #include <set>
 #include <map>
+#include <cstdlib>
+#include <cmath>
+#include <iterator>
+#include <cstdio>
+#include <chrono>
 
 namespace fs = std::filesystem;
 
@@ -36,9 +43,32 @@ bool isRunningInDockerInternal() {
 
 Game::Game() 
     : window(sf::VideoMode(1200, 800), "Memory Game", sf::Style::Titlebar | sf::Style::Close | sf::Style::Resize),
+      hasProfileStats(false),
+      profileVersion(0),
+      themeLoader(resourceCache),
       brightness(1.0f),
       currentVideoMode(1200, 800),
       currentVideoModeIndex(2),
+      renderedState(GameState::MAIN_MENU),
+      screenRevision(0),
+      needsRedraw(true),
+      simulationAccumulator(0.0f),
+      renderAlpha(1.0f),
+      presentMode(PresentMode::CAPPED),
+      frameRateLimit(60),
+      logFrameStats(false),
+      boardZoom(1.0f),
+      boardCenter(0.0f, 0.0f),
+      visibleCells(0, 0, 0, 0),
+      isPanning(false),
+      panAnchor(0, 0),
+      customRows(DefaultCustomSide),
+      customCols(DefaultCustomSide),
+      hasFocus(true),
+      lastTimerSeconds(-1),
+      lastCardsRevision(0),
+      renderTarget(&window),
+      drawCalls(0),
       currentState(GameState::MAIN_MENU),
       previousState(GameState::MAIN_MENU),
       difficulty(Difficulty::MEDIUM),
@@ -46,27 +76,62 @@ Game::Game()
       rows(4),
       cols(4),
       totalPairs(8),
-      matchedPairs(0),
-      moves(0),
       isGameActive(false),
-      firstCardSelected(false),
-      selectedCard1(-1),
-      selectedCard2(-1),
       cardFlipTime(0.3f),
-      cardFlipProgress(0.0f),
+      mismatchDelay(0.8f),
       isFlipping(false),
-      firstCard(nullptr),
-      secondCard(nullptr),
+      dealSeed(0),
+      fixedDealSeed(0),
+      symbolCount(0),
       isChecking(false),
-      hasWon(false)
+      hasWon(false),
+      saveStatus(SaveStatus::NONE),
+      saveGeneration(0)
 {
-    std::cout << "=== ИНИЦИАЛИЗАЦИЯ ИГРЫ ===" << std::endl;
-    window.setFramerateLimit(60);
+    TRACE_SCOPE("Game::Game");
+    LOG_INFO("=== ИНИЦИАЛИЗАЦИЯ ИГРЫ ===");
+    
+    // Показ кадров: capped (по умолчанию), vsync или uncapped
+    if (const char* present = std::getenv("MEMORY_GAME_PRESENT")) {
+        std::string mode = present;
+        if (mode == "vsync") {
+            presentMode = PresentMode::VSYNC;
+        } else if (mode == "uncapped") {
+            presentMode = PresentMode::UNCAPPED;
+        }
+    }
+    if (const char* fps = std::getenv("MEMORY_GAME_FPS")) {
+        int limit = std::atoi(fps);
+        if (limit > 0) {
+            frameRateLimit = limit;
+        }
+    }
+    if (const char* stats = std::getenv("MEMORY_GAME_FRAME_STATS")) {
+        logFrameStats = std::string(stats) == "1";
+    }
+    applyPresentMode();
+    
+    // Бюджет кэша текстур и изображений можно задать в мегабайтах
+    if (const char* cacheMb = std::getenv("MEMORY_GAME_CACHE_MB")) {
+        int megabytes = std::atoi(cacheMb);
+        if (megabytes > 0) {
+            resourceCache.setBudget(static_cast<std::size_t>(megabytes) * 1024 * 1024);
+            LOG_INFO("Бюджет кэша ресурсов: " << megabytes << " МБ");
+        }
+    }
     window.setKeyRepeatEnabled(false);
     
-    std::cout << "Настройки по умолчанию:" << std::endl;
-    std::cout << "  Сложность: Medium (4x4)" << std::endl;
-    std::cout << "  Всего пар: " << totalPairs << std::endl;
+    // Постоянное зерно раскладки - одинаковые партии для замеров
+    if (const char* seed = std::getenv("MEMORY_GAME_SEED")) {
+        fixedDealSeed = std::strtoull(seed, nullptr, 10);
+        if (fixedDealSeed != 0) {
+            LOG_INFO("Зерно раскладки: " << fixedDealSeed);
+        }
+    }
+    
+    LOG_INFO("Настройки по умолчанию:");
+    LOG_INFO("  Сложность: Medium (4x4)");
+    LOG_INFO("  Всего пар: " << totalPairs);
     
     // Доступные разрешения
     availableVideoModes = {
@@ -79,9 +144,10 @@ Game::Game()
     };
     
     // Загрузка ресурсов
-    std::cout << "Загрузка ресурсов..." << std::endl;
+    LOG_INFO("Загрузка ресурсов...");
     loadResources();
-    std::cout << "Ресурсы загружены" << std::endl;
+    profilerOverlay.setFont(mainFont);
+    LOG_INFO("Ресурсы загружены");
     
     // Кнопка сдачи
     surrenderButton = Button(950, 700, 200, 50, "Surrender", mainFont, 
@@ -94,6 +160,7 @@ Game::Game()
     setupPauseMenu();
     setupSetupMenu();
     setupLeaderboardUI();
+    setupProfileUI();
     setupSettingsMenu();
     setupContactForm();
     
@@ -102,55 +169,47 @@ Game::Game()
     musicPlayer = std::make_unique<MusicPlayer>();
     
     // === ПРОСТАЯ ИНИЦИАЛИЗАЦИЯ БАЗЫ ДАННЫХ ===
-    std::string dbPath = "memory_game.db";
-    
-    // Проверяем Docker простым способом
-    std::ifstream dockerFile("/.dockerenv");
-    if (dockerFile.good()) {
-        std::cout << "🐳 Запущено в Docker" << std::endl;
-        dbPath = "/app/database/memory_game.db";
-        std::cout << "📁 Путь к БД в Docker: " << dbPath << std::endl;
-        
-        // Просто пытаемся создать директорию
-        system("mkdir -p /app/database 2>/dev/null");
-    } else {
-        std::cout << "💻 Запущено локально" << std::endl;
-        std::cout << "📁 Путь к БД локально: " << dbPath << std::endl;
-    }
+    std::string dbPath = Database::defaultPath();
+    LOG_INFO("📁 Путь к БД: " << dbPath);
+    
+    // Повторы партий лежат рядом с БД
+    replayDir = (std::filesystem::path(dbPath).parent_path() / "replays").string();
     
     // Пытаемся создать базу данных
     try {
-        std::cout << "Создаем базу данных..." << std::endl;
+        LOG_INFO("Создаем базу данных...");
         database = std::make_unique<Database>(dbPath);
         
         if (database->initialize()) {
-            std::cout << "✅ База данных инициализирована" << std::endl;
+            LOG_INFO("✅ База данных инициализирована");
+            persistence = std::make_unique<PersistenceWorker>(*database);
             
             // Проверяем что-нибудь в базе
             auto testRecords = database->getTopScores(1);
             if (!testRecords.empty()) {
-                std::cout << "📊 В базе найдено записей: " << testRecords.size() << std::endl;
+                LOG_INFO("📊 В базе найдено записей: " << testRecords.size());
             } else {
-                std::cout << "📊 База данных пуста (первый запуск)" << std::endl;
+                LOG_INFO("📊 База данных пуста (первый запуск)");
             }
         } else {
-            std::cout << "⚠ Не удалось инициализировать БД" << std::endl;
+            LOG_WARN("⚠ Не удалось инициализировать БД");
             database = nullptr;
         }
     } catch (const std::exception& e) {
-        std::cerr << "❌ Ошибка при создании БД: " << e.what() << std::endl;
-        std::cout << "⚠ Продолжаем без базы данных" << std::endl;
+        LOG_ERROR("❌ Ошибка при создании БД: " << e.what());
+        LOG_WARN("⚠ Продолжаем без базы данных");
         database = nullptr;
     }
     
-    std::cout << "=== ИНИЦИАЛИЗАЦИЯ ЗАВЕРШЕНА ===" << std::endl;
+    LOG_INFO("=== ИНИЦИАЛИЗАЦИЯ ЗАВЕРШЕНА ===");
 }
 
 Game::~Game() {
-    std::cout << "Игра завершена." << std::endl;
+    LOG_INFO("Игра завершена.");
 }
 
 void Game::loadResources() {
+    TRACE_SCOPE("Game::loadResources");
     // Загрузка шрифта
     std::vector<std::string> fontPaths = {
         "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
@@ -165,7 +224,7 @@ void Game::loadResources() {
     for (const auto& path : fontPaths) {
         if (mainFont.loadFromFile(path)) {
             fontLoaded = true;
-            std::cout << "Шрифт загружен: " << path << std::endl;
+            LOG_INFO("Шрифт загружен: " << path);
             break;
         }
     }
@@ -232,7 +291,7 @@ void Game::loadResources() {
 }
 
 void Game::setupContactForm() {
-    std::cout << "Настройка формы обратной связи..." << std::endl;
+    LOG_INFO("Настройка формы обратной связи...");
     
     // Пытаемся загрузить шрифт для формы
     std::vector<std::string> fontPaths = {
@@ -243,7 +302,7 @@ void Game::setupContactForm() {
     
     for (const auto& path : fontPaths) {
         if (contactForm.loadFont(path)) {
-            std::cout << "Шрифт для формы загружен: " << path << std::endl;
+            LOG_INFO("Шрифт для формы загружен: " << path);
             break;
         }
     }
@@ -254,28 +313,216 @@ void Game::setupContactForm() {
 
 void Game::updateBackgrounds() {
     // Применяем яркость
-    sf::Color adjustedMenuColor(
+    menuBackgroundTint = sf::Color(
         std::min(255, int(menuBackgroundColor.r * brightness)),
         std::min(255, int(menuBackgroundColor.g * brightness)),
         std::min(255, int(menuBackgroundColor.b * brightness))
     );
     
-    sf::Color adjustedGameColor(
+    gameBackgroundTint = sf::Color(
         std::min(255, int(gameBackgroundColor.r * brightness)),
         std::min(255, int(gameBackgroundColor.g * brightness)),
         std::min(255, int(gameBackgroundColor.b * brightness))
     );
     
-    // Создаем текстуры
-    sf::Image menuImage;
-    menuImage.create(window.getSize().x, window.getSize().y, adjustedMenuColor);
-    menuBackgroundTexture.loadFromImage(menuImage);
+    background.setSize(sf::Vector2f(window.getSize().x, window.getSize().y));
+}
+
+void Game::layoutUI() {
+    // Пересчёт позиций по размеру окна - без пересоздания кнопок и карт
+    sf::Vector2u size = window.getSize();
+    
+    titleText.setPosition(size.x / 2, titleText.getPosition().y);
+    settingsTitle.setPosition(size.x / 2 - 200, 100);
+    
+    layoutColumn(mainMenuButtons, 300.0f, 300.0f, 80.0f);
+    layoutColumn(settingsButtons, 300.0f, 200.0f, 80.0f);
+    layoutColumn(setupButtons, 300.0f, 200.0f, 100.0f);
+    layoutColumn(pauseButtons, 250.0f, 350.0f, 80.0f);
+    
+    for (std::size_t i = 0; i < gameButtons.size(); i++) {
+        gameButtons[i].setPosition(size.x - 200, 50.0f + 50.0f * i);
+    }
+    surrenderButton.setPosition(size.x - 250, size.y - 100);
+    
+    if (leaderboardButtons.size() >= 3) {
+        leaderboardButtons[0].setPosition(size.x / 2 - 100, size.y - 100);
+        leaderboardButtons[1].setPosition(size.x / 2 - 360, size.y - 100);
+        leaderboardButtons[2].setPosition(size.x / 2 + 120, size.y - 100);
+    }
+    if (!profileButtons.empty()) {
+        profileButtons[0].setPosition(size.x / 2 - 100, size.y - 100);
+    }
+    
+    // Карты стоят в координатах поля - при новом размере окна меняется только вид
+    updateBoardView();
+}
+
+void Game::layoutColumn(std::vector<Button>& buttons, float width, float startY, float spacing) {
+    float x = window.getSize().x / 2 - width / 2;
+    for (std::size_t i = 0; i < buttons.size(); i++) {
+        buttons[i].setPosition(x, startY + spacing * i);
+    }
+}
+
+sf::Vector2f Game::getCardPosition(int index) const {
+    // Координаты поля: левая верхняя карта в (0, 0), на экран их переводит boardView
+    int row = index / cols;
+    int col = index % cols;
+    return sf::Vector2f(col * (CardSize + CardSpacing),
+                        row * (CardSize + CardSpacing));
+}
+
+void Game::resetBoardView() {
+    // Поле целиком, если помещается; иначе наибольший масштаб из допустимых
+    sf::Vector2u size = window.getSize();
+    float boardWidth = cols * CardSize + (cols - 1) * CardSpacing;
+    float boardHeight = rows * CardSize + (rows - 1) * CardSpacing;
+    float fitZoom = std::max(boardWidth / std::max(1.0f, size.x - 2 * BoardPanMargin),
+                             boardHeight / std::max(1.0f, size.y - 2 * BoardTopOffset - CardSpacing));
+    
+    boardZoom = std::min(MaxBoardZoom, std::max(1.0f, fitZoom));
+    boardCenter = sf::Vector2f(boardWidth / 2, boardHeight / 2 - BoardTopOffset * boardZoom);
+    isPanning = false;
+    updateBoardView();
+}
+
+void Game::updateBoardView() {
+    sf::Vector2u size = window.getSize();
+    sf::Vector2f viewSize(size.x * boardZoom, size.y * boardZoom);
+    float boardWidth = cols * CardSize + (cols - 1) * CardSpacing;
+    float boardHeight = rows * CardSize + (rows - 1) * CardSpacing;
+    float margin = BoardPanMargin * boardZoom;
+    
+    // Поле, которое помещается по оси, стоит по центру; иначе прокрутка
+    // ограничена краями поля с небольшим запасом
+    if (boardWidth + 2 * margin <= viewSize.x) {
+        boardCenter.x = boardWidth / 2;
+    } else {
+        boardCenter.x = std::max(viewSize.x / 2 - margin,
+                                 std::min(boardWidth - viewSize.x / 2 + margin, boardCenter.x));
+    }
+    if (boardHeight + 2 * margin <= viewSize.y) {
+        boardCenter.y = boardHeight / 2 - BoardTopOffset * boardZoom;
+    } else {
+        boardCenter.y = std::max(viewSize.y / 2 - margin,
+                                 std::min(boardHeight - viewSize.y / 2 + margin, boardCenter.y));
+    }
+    
+    boardView.setSize(viewSize);
+    boardView.setCenter(boardCenter);
+    
+    // Видимые клетки с запасом на рамку карточки
+    float step = CardSize + CardSpacing;
+    float left = boardCenter.x - viewSize.x / 2 - CardSpacing;
+    float top = boardCenter.y - viewSize.y / 2 - CardSpacing;
+    int firstCol = std::max(0, static_cast<int>(std::floor(left / step)));
+    int firstRow = std::max(0, static_cast<int>(std::floor(top / step)));
+    int lastCol = std::min(cols, static_cast<int>(std::floor((left + viewSize.x + 2 * CardSpacing) / step)) + 1);
+    int lastRow = std::min(rows, static_cast<int>(std::floor((top + viewSize.y + 2 * CardSpacing) / step)) + 1);
+    
+    visibleCells = sf::IntRect(firstCol, firstRow,
+                               std::max(0, lastCol - firstCol), std::max(0, lastRow - firstRow));
+    markDirty();
+}
+
+void Game::zoomBoard(float factor, const sf::Vector2i& pixel) {
+    float zoom = std::min(MaxBoardZoom, std::max(MinBoardZoom, boardZoom * factor));
+    if (zoom == boardZoom) {
+        return;
+    }
+    
+    // Точка поля под курсором остаётся на месте
+    sf::Vector2f before = window.mapPixelToCoords(pixel, boardView);
+    boardZoom = zoom;
+    boardView.setSize(window.getSize().x * zoom, window.getSize().y * zoom);
+    sf::Vector2f after = window.mapPixelToCoords(pixel, boardView);
+    
+    boardCenter += before - after;
+    updateBoardView();
+}
+
+void Game::panBoard(const sf::Vector2f& pixels) {
+    boardCenter += pixels * boardZoom;
+    updateBoardView();
+}
+
+int Game::findCardAt(const sf::Vector2i& pixel) const {
+    sf::Vector2f point = window.mapPixelToCoords(pixel, boardView);
+    if (point.x < 0 || point.y < 0) {
+        return -1;
+    }
+    
+    // Клетка сетки под точкой; промежутки между картами не считаются
+    float step = CardSize + CardSpacing;
+    int col = static_cast<int>(point.x / step);
+    int row = static_cast<int>(point.y / step);
+    if (col >= cols || row >= rows ||
+        point.x - col * step > CardSize || point.y - row * step > CardSize) {
+        return -1;
+    }
     
-    sf::Image gameImage;
-    gameImage.create(window.getSize().x, window.getSize().y, adjustedGameColor);
-    gameBackgroundTexture.loadFromImage(gameImage);
+    int index = row * cols + col;
+    return index < static_cast<int>(cards.size()) ? index : -1;
+}
+
+bool Game::handleBoardEvent(const sf::Event& event) {
+    // Прокрутка правой кнопкой мыши или стрелками, масштаб колесом и +/-,
+    // Home возвращает исходный вид
+    switch (event.type) {
+        case sf::Event::MouseButtonPressed:
+            if (event.mouseButton.button == sf::Mouse::Right) {
+                isPanning = true;
+                panAnchor = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+                return true;
+            }
+            break;
+            
+        case sf::Event::MouseButtonReleased:
+            if (event.mouseButton.button == sf::Mouse::Right) {
+                isPanning = false;
+                return true;
+            }
+            break;
+            
+        case sf::Event::MouseMoved:
+            if (isPanning) {
+                sf::Vector2i position(event.mouseMove.x, event.mouseMove.y);
+                panBoard(sf::Vector2f(panAnchor - position));
+                panAnchor = position;
+                return true;
+            }
+            break;
+            
+        case sf::Event::MouseWheelScrolled:
+            zoomBoard(std::pow(0.9f, event.mouseWheelScroll.delta),
+                      sf::Vector2i(event.mouseWheelScroll.x, event.mouseWheelScroll.y));
+            return true;
+            
+        case sf::Event::KeyPressed:
+            switch (event.key.code) {
+                case sf::Keyboard::Left: panBoard(sf::Vector2f(-100, 0)); return true;
+                case sf::Keyboard::Right: panBoard(sf::Vector2f(100, 0)); return true;
+                case sf::Keyboard::Up: panBoard(sf::Vector2f(0, -100)); return true;
+                case sf::Keyboard::Down: panBoard(sf::Vector2f(0, 100)); return true;
+                case sf::Keyboard::Add:
+                case sf::Keyboard::Equal:
+                    zoomBoard(0.8f, sf::Vector2i(window.getSize() / 2u));
+                    return true;
+                case sf::Keyboard::Subtract:
+                case sf::Keyboard::Hyphen:
+                    zoomBoard(1.25f, sf::Vector2i(window.getSize() / 2u));
+                    return true;
+                case sf::Keyboard::Home: resetBoardView(); return true;
+                default: break;
+            }
+            break;
+            
+        default:
+            break;
+    }
     
-    background.setTexture(menuBackgroundTexture);
+    return false;
 }
 
 void Game::setupMainMenu() {
@@ -300,12 +547,18 @@ void Game::setupMainMenu() {
     
     mainMenuButtons.emplace_back(
         450.0f, startY + spacing * 2, buttonWidth, buttonHeight, 
+        "Profile", mainFont, 
+        [this]() { showProfile(); }
+    );
+    
+    mainMenuButtons.emplace_back(
+        450.0f, startY + spacing * 3, buttonWidth, buttonHeight, 
         "Settings", mainFont, 
         [this]() { showSettings(); }
     );
     
     mainMenuButtons.emplace_back(
-        450.0f, startY + spacing * 3, buttonWidth, buttonHeight, 
+        450.0f, startY + spacing * 4, buttonWidth, buttonHeight, 
         "Exit", mainFont, 
         [this]() { exitGame(); }
     );
@@ -354,15 +607,31 @@ void Game::setupSettingsMenu() {
             
             window.create(currentVideoMode, "Memory Game", 
                          sf::Style::Titlebar | sf::Style::Close | sf::Style::Resize);
-            window.setFramerateLimit(60);
+            applyPresentMode();
             
             updateBackgrounds();
+            layoutUI();
         }
     );
     
-    // Обратная связь
+    // Показ кадров
     settingsButtons.emplace_back(
         centerX, startY + spacing * 2, buttonWidth, buttonHeight,
+        std::string("Present: ") + getPresentModeName(presentMode), mainFont,
+        [this]() { 
+            switch (presentMode) {
+                case PresentMode::CAPPED: presentMode = PresentMode::VSYNC; break;
+                case PresentMode::VSYNC: presentMode = PresentMode::UNCAPPED; break;
+                case PresentMode::UNCAPPED: presentMode = PresentMode::CAPPED; break;
+            }
+            settingsButtons[2].setText(std::string("Present: ") + getPresentModeName(presentMode));
+            applyPresentMode();
+        }
+    );
+    
+    // Обратная связь
+    settingsButtons.emplace_back(
+        centerX, startY + spacing * 3, buttonWidth, buttonHeight,
         "Contact Developer", mainFont,
         [this]() { 
             previousState = currentState;
@@ -373,19 +642,19 @@ void Game::setupSettingsMenu() {
     
     // Назад
     settingsButtons.emplace_back(
-        centerX, startY + spacing * 3, buttonWidth, buttonHeight,
+        centerX, startY + spacing * 4, buttonWidth, buttonHeight,
         "Back to Menu", mainFont,
         [this]() { 
             currentState = GameState::MAIN_MENU;
-            background.setTexture(menuBackgroundTexture);
         }
     );
     
     // Цвета кнопок
     settingsButtons[0].setColors(sf::Color(138, 43, 226), sf::Color(148, 0, 211), sf::Color(128, 0, 128));
     settingsButtons[1].setColors(sf::Color(138, 43, 226), sf::Color(148, 0, 211), sf::Color(128, 0, 128));
-    settingsButtons[2].setColors(sf::Color(70, 130, 180), sf::Color(100, 149, 237), sf::Color(30, 144, 255));
-    settingsButtons[3].setColors(sf::Color(220, 20, 60), sf::Color(255, 0, 0), sf::Color(178, 34, 34));
+    settingsButtons[2].setColors(sf::Color(138, 43, 226), sf::Color(148, 0, 211), sf::Color(128, 0, 128));
+    settingsButtons[3].setColors(sf::Color(70, 130, 180), sf::Color(100, 149, 237), sf::Color(30, 144, 255));
+    settingsButtons[4].setColors(sf::Color(220, 20, 60), sf::Color(255, 0, 0), sf::Color(178, 34, 34));
 }
 
 void Game::setupGameUI() {
@@ -405,7 +674,6 @@ void Game::setupGameUI() {
         "Menu", mainFont,
         [this]() { 
             currentState = GameState::MAIN_MENU;
-            background.setTexture(menuBackgroundTexture);
         }
     );
     
@@ -443,7 +711,6 @@ void Game::setupPauseMenu() {
     pauseButtons.emplace_back(centerX, startY + spacing * 2, buttonWidth, buttonHeight, "Main Menu", mainFont, 
                              [this]() { 
                                  currentState = GameState::MAIN_MENU;
-                                 background.setTexture(menuBackgroundTexture); 
                              });
     
     for (auto& button : pauseButtons) {
@@ -477,6 +744,10 @@ void Game::setupSetupMenu() {
                 setupButtons[0].setText("Difficulty: Expert"); 
                 break;
             case Difficulty::EXPERT: 
+                setDifficulty(Difficulty::CUSTOM); 
+                setupButtons[0].setText("Difficulty: Custom"); 
+                break;
+            case Difficulty::CUSTOM: 
                 setDifficulty(Difficulty::EASY); 
                 setupButtons[0].setText("Difficulty: Easy"); 
                 break;
@@ -514,12 +785,16 @@ void Game::setupSetupMenu() {
     setupButtons.emplace_back(centerX, startY + spacing * 2, buttonWidth, buttonHeight, "Start Game!", mainFont, 
                              [this]() { 
         if (player) {
-            resetGame();
-            currentState = GameState::PLAYING;
-            background.setTexture(gameBackgroundTexture);
-            isGameActive = true;
-            gameClock.restart();
-            std::cout << "Игра начата! Всего пар: " << totalPairs << std::endl;
+            std::string imageDir = getThemeImageDir(currentTheme);
+            themeAtlas = findThemeAtlas(imageDir);
+            
+            if (themeAtlas) {
+                startPlaying();
+            } else {
+                // Тема ещё грузится в фоне - показываем прогресс
+                prefetchTheme(currentTheme);
+                currentState = GameState::LOADING;
+            }
         }
     });
     
@@ -557,6 +832,76 @@ void Game::setupLeaderboardUI() {
     });
     
     leaderboardButtons[0].setColors(sf::Color(70, 130, 180), sf::Color(100, 149, 237), sf::Color(30, 144, 255));
+    
+    // Выбор таблицы: сложность и тема, "All" - сводная
+    leaderboardButtons.emplace_back(centerX - 260, buttonY, 240, buttonHeight, "", mainFont,
+                                   [this]() { cycleLeaderboardDifficulty(); });
+    leaderboardButtons.emplace_back(centerX + 220, buttonY, 240, buttonHeight, "", mainFont,
+                                   [this]() { cycleLeaderboardTheme(); });
+    updateLeaderboardButtons();
+}
+
+void Game::setupProfileUI() {
+    profileButtons.clear();
+    
+    profileButtons.emplace_back(window.getSize().x / 2 - 100, window.getSize().y - 100, 200, 50,
+                                "Back to Menu", mainFont,
+                                [this]() { currentState = GameState::MAIN_MENU; });
+    profileButtons[0].setColors(sf::Color(70, 130, 180), sf::Color(100, 149, 237), sf::Color(30, 144, 255));
+}
+
+void Game::cycleLeaderboardDifficulty() {
+    // Свои поля разных размеров - разные таблицы; в списке текущий размер
+    BoardSize custom = getCustomBoardSize(customRows, customCols);
+    const std::string options[] = {
+        Database::AnyBoard,
+        getDifficultyName(Difficulty::EASY),
+        getDifficultyName(Difficulty::MEDIUM),
+        getDifficultyName(Difficulty::HARD),
+        getDifficultyName(Difficulty::EXPERT),
+        std::string(getDifficultyName(Difficulty::CUSTOM)) + " " +
+            std::to_string(custom.rows) + "x" + std::to_string(custom.cols)
+    };
+    
+    const std::string& current = leaderboard.getDifficulty();
+    auto it = std::find(std::begin(options), std::end(options), current);
+    std::size_t next = it == std::end(options) ? 0 : (it - std::begin(options) + 1) % std::size(options);
+    leaderboard.setBoard(options[next], leaderboard.getTheme());
+    updateLeaderboardButtons();
+}
+
+void Game::cycleLeaderboardTheme() {
+    const CardTheme themes[] = {
+        CardTheme::ANIMALS, CardTheme::FRUITS, CardTheme::EMOJI, CardTheme::MEMES, CardTheme::SYMBOLS
+    };
+    
+    // Все -> темы по порядку -> все
+    const std::string& current = leaderboard.getTheme();
+    std::string next = getThemeName(themes[0]);
+    if (current != Database::AnyBoard) {
+        next = Database::AnyBoard;
+        for (std::size_t i = 0; i + 1 < std::size(themes); i++) {
+            if (current == getThemeName(themes[i])) {
+                next = getThemeName(themes[i + 1]);
+            }
+        }
+    }
+    
+    leaderboard.setBoard(leaderboard.getDifficulty(), next);
+    updateLeaderboardButtons();
+}
+
+void Game::updateLeaderboardButtons() {
+    if (leaderboardButtons.size() < 3) {
+        return;
+    }
+    
+    auto label = [](const std::string& board) {
+        return board == Database::AnyBoard ? std::string("All") : board;
+    };
+    leaderboardButtons[1].setText("Difficulty: " + label(leaderboard.getDifficulty()));
+    leaderboardButtons[2].setText("Theme: " + label(leaderboard.getTheme()));
+    screenRevision++;
 }
 
 void Game::getImagePathsForTheme(CardTheme theme, std::vector<std::string>& imagePaths) {
@@ -572,7 +917,7 @@ void Game::getImagePathsForTheme(CardTheme theme, std::vector<std::string>& imag
     }
     
     std::string imageDir = "assets/images/" + themeFolder + "/";
-    std::cout << "📁 Поиск изображений в: " << imageDir << std::endl;
+    LOG_DEBUG("📁 Поиск изображений в: " << imageDir);
     
     imagePaths.clear();
     
@@ -588,20 +933,20 @@ void Game::getImagePathsForTheme(CardTheme theme, std::vector<std::string>& imag
                     foundCount++;
                     
                     if (foundCount <= 5) {
-                        std::cout << "   ✅ " << entry.path().filename() << std::endl;
+                        LOG_DEBUG("   ✅ " << entry.path().filename());
                     }
                 }
             }
         }
         
         if (foundCount > 5) {
-            std::cout << "   ... и еще " << (foundCount - 5) << " файлов" << std::endl;
+            LOG_DEBUG("   ... и еще " << (foundCount - 5) << " файлов");
         }
         
-        std::cout << "📊 Найдено файлов: " << foundCount << std::endl;
+        LOG_DEBUG("📊 Найдено файлов: " << foundCount);
         
     } catch (const std::exception& e) {
-        std::cout << "❌ Ошибка доступа к папке: " << e.what() << std::endl;
+        LOG_ERROR("❌ Ошибка доступа к папке: " << e.what());
         // Создаем тестовые пути
         for (int i = 1; i <= 18; i++) {
             imagePaths.push_back(imageDir + "image" + std::to_string(i) + ".png");
@@ -610,450 +955,742 @@ void Game::getImagePathsForTheme(CardTheme theme, std::vector<std::string>& imag
 }
 
 void Game::initializeCards() {
+    TRACE_SCOPE("Game::initializeCards");
     gameCards.clear();
     
     // Устанавливаем размеры
-    switch (difficulty) {
-        case Difficulty::EASY: rows = 3; cols = 4; totalPairs = 6; break;
-        case Difficulty::MEDIUM: rows = 4; cols = 4; totalPairs = 8; break;
-        case Difficulty::HARD: rows = 4; cols = 6; totalPairs = 12; break;
-        case Difficulty::EXPERT: rows = 6; cols = 6; totalPairs = 18; break;
-    }
+    BoardSize size = difficulty == Difficulty::CUSTOM ? getCustomBoardSize(customRows, customCols)
+                                                      : getBoardSize(difficulty);
+    rows = size.rows;
+    cols = size.cols;
+    totalPairs = size.totalPairs;
     
     int totalCards = rows * cols;
-    std::cout << "\n=== ИНИЦИАЛИЗАЦИЯ КАРТ ===" << std::endl;
-    std::cout << "Поле: " << rows << "x" << cols << " = " << totalCards << " карт" << std::endl;
-    std::cout << "Нужно пар: " << totalPairs << std::endl;
-    
-    // 1. Получаем файлы из папки текущей темы
-    std::string themeFolder;
-    switch (currentTheme) {
-        case CardTheme::ANIMALS: themeFolder = "animals"; break;
-        case CardTheme::FRUITS: themeFolder = "fruits"; break;
-        case CardTheme::EMOJI: themeFolder = "emoji"; break;
-        case CardTheme::MEMES: themeFolder = "memes"; break;
-        case CardTheme::SYMBOLS: themeFolder = "symbols"; break;
-        default: themeFolder = "animals"; break;
+    LOG_DEBUG("=== ИНИЦИАЛИЗАЦИЯ КАРТ ===");
+    LOG_DEBUG("Поле: " << rows << "x" << cols << " = " << totalCards << " карт");
+    LOG_DEBUG("Нужно пар: " << totalPairs);
+    
+    // 1. Изображения текущей темы берём из атласа (собирается один раз на тему)
+    std::string imageDir = getThemeImageDir(currentTheme);
+    if (!themeAtlas || !themeAtlas->isBuiltFor(imageDir)) {
+        themeAtlas = findThemeAtlas(imageDir);
+    }
+    if (!themeAtlas) {
+        // Фоновая загрузка не успела или не удалась - собираем синхронно
+        themeAtlas = acquireThemeAtlas(imageDir);
     }
     
-    std::string imageDir = "assets/images/" + themeFolder + "/";
-    std::cout << "Ищем изображения в: " << imageDir << std::endl;
-    
-    // 2. Собираем список доступных файлов
-    std::vector<std::string> availableImages;
-    try {
-        for (const auto& entry : fs::directory_iterator(imageDir)) {
-            if (entry.is_regular_file()) {
-                std::string ext = entry.path().extension().string();
-                std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                
-                if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp") {
-                    availableImages.push_back(entry.path().string());
-                    std::cout << "  Найдено: " << entry.path().filename() << std::endl;
-                }
-            }
-        }
-    } catch (const std::exception& e) {
-        std::cout << "Ошибка доступа к папке: " << e.what() << std::endl;
+    // 2. Символы темы получают номера один раз; номер символа = номер пары
+    SymbolTable& symbols = themeSymbols[currentTheme];
+    std::vector<std::uint16_t> symbolIds;
+    for (const auto& path : themeAtlas->getImagePaths()) {
+        symbolIds.push_back(symbols.intern(path));
     }
+    LOG_DEBUG("Изображений в атласе: " << symbolIds.size());
     
     // 3. Если нет файлов, создаем тестовые имена
-    if (availableImages.empty()) {
-        std::cout << "Файлы не найдены, создаем тестовые..." << std::endl;
+    if (symbolIds.empty()) {
+        LOG_DEBUG("Файлы не найдены, создаем тестовые...");
         for (int i = 1; i <= totalPairs; i++) {
-            availableImages.push_back(imageDir + "image" + std::to_string(i) + ".png");
+            symbolIds.push_back(symbols.intern(imageDir + "image" + std::to_string(i) + ".png"));
         }
     }
     
-    // 4. ГАРАНТИРУЕМ ПАРНОСТЬ
-    std::vector<std::string> pairedImages;
-    
-    // Берем первые totalPairs уникальных изображений
-    int imagesToUse = std::min(totalPairs, (int)availableImages.size());
-    for (int i = 0; i < imagesToUse; i++) {
-        pairedImages.push_back(availableImages[i % availableImages.size()]);
-    }
-    
-    // Если нужно больше пар, чем есть уникальных изображений - дублируем
-    while ((int)pairedImages.size() < totalPairs) {
-        pairedImages.push_back(availableImages[pairedImages.size() % availableImages.size()]);
+    // 4-6. Раскладку делает движок по зерну: пара i - символ i по кругу,
+    // затем перемешивание. Зерно сохраняется с партией для повтора
+    if (fixedDealSeed != 0) {
+        dealSeed = fixedDealSeed;
+    } else {
+        std::random_device rd;
+        dealSeed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
     }
     
-    std::cout << "Используем " << pairedImages.size() << " изображений для пар" << std::endl;
+    LOG_DEBUG("Используем " << totalPairs << " пар из " << symbolIds.size() << " символов");
+    LOG_DEBUG("Зерно раскладки: " << dealSeed);
     
-    // 5. СОЗДАЕМ КАРТЫ ПАРАМИ
-    int cardId = 0;
-    for (int i = 0; i < totalPairs; i++) {
-        std::string imagePath = pairedImages[i];
-        
-        // Первая карта пары
-        gameCards.emplace_back(cardId++, imagePath, currentTheme);
-        // Вторая карта пары (ТА ЖЕ САМАЯ!)
-        gameCards.emplace_back(cardId++, imagePath, currentTheme);
-        
-        std::string filename = fs::path(imagePath).filename().string();
-        std::cout << "  Пара #" << (i+1) << ": " << filename 
-                  << " (ID: " << (cardId-2) << " и " << (cardId-1) << ")" << std::endl;
+    if (!board.deal(rows, cols, BoardEngine::makePairs(symbolIds, totalPairs), dealSeed)) {
+        LOG_ERROR("❌ ОШИБКА: движок не принял поле " << rows << "x" << cols);
     }
     
-    // 6. Перемешиваем
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(gameCards.begin(), gameCards.end(), g);
+    // 7. Данные карт - по раскладке движка
+    gameCards.reserve(board.getCardCount());
+    for (int i = 0; i < board.getCardCount(); i++) {
+        std::uint16_t pairId = board.getPairId(i);
+        gameCards.emplace_back(static_cast<std::uint16_t>(i), pairId, currentTheme, symbols.isImage(pairId));
+    }
     
-    // 7. ПРОВЕРКА
-    std::cout << "\n📊 ПРОВЕРКА:" << std::endl;
-    std::cout << "Всего карт: " << gameCards.size() << std::endl;
-    std::cout << "Должно быть: " << totalCards << std::endl;
+    LOG_DEBUG("📊 ПРОВЕРКА:");
+    LOG_DEBUG("Всего карт: " << gameCards.size());
+    LOG_DEBUG("Должно быть: " << totalCards);
     
     if (gameCards.size() == static_cast<size_t>(totalCards)) {
-        std::cout << "✅ Размер правильный!" << std::endl;
+        LOG_DEBUG("✅ Размер правильный!");
     } else {
-        std::cout << "❌ ОШИБКА: неверное количество карт!" << std::endl;
-        // Корректируем
-        if (gameCards.size() > static_cast<size_t>(totalCards)) {
-            gameCards.resize(totalCards);
-        } else {
-            while (gameCards.size() < static_cast<size_t>(totalCards)) {
-                std::string fallback = pairedImages[gameCards.size() % pairedImages.size()];
-                gameCards.emplace_back(cardId++, fallback, currentTheme);
-            }
-        }
+        LOG_ERROR("❌ ОШИБКА: неверное количество карт!");
     }
     
-    std::cout << "=== ИНИЦИАЛИЗАЦИЯ ЗАВЕРШЕНА ===\n" << std::endl;
+    symbolCount = static_cast<int>(symbolIds.size());
+    
+    LOG_DEBUG("=== ИНИЦИАЛИЗАЦИЯ ЗАВЕРШЕНА ===");
 }
 
 void Game::createCardSprites() {
+    TRACE_SCOPE("Game::createCardSprites");
     cards.clear();
+    animatingCards.clear();
+    boardRenderer.invalidate();
     
-    // Размеры карточек
-    float cardSize = 80.0f;
-    float spacing = 10.0f;
-    
-    // Центрируем игровое поле
-    float totalWidth = cols * cardSize + (cols - 1) * spacing;
-    float totalHeight = rows * cardSize + (rows - 1) * spacing;
-    float startX = (window.getSize().x - totalWidth) / 2;
-    float startY = (window.getSize().y - totalHeight) / 2 + 50;
+    const SymbolTable& symbols = themeSymbols[currentTheme];
     
-    std::cout << "\n=== СОЗДАНИЕ СПРАЙТОВ КАРТ ===" << std::endl;
-    std::cout << "Создание " << (rows * cols) << " спрайтов..." << std::endl;
+    LOG_DEBUG("=== СОЗДАНИЕ СПРАЙТОВ КАРТ ===");
+    LOG_DEBUG("Создание " << (rows * cols) << " спрайтов...");
     
     // Создаем спрайты карточек
     for (int i = 0; i < rows * cols && i < static_cast<int>(gameCards.size()); i++) {
-        int row = i / cols;
-        int col = i % cols;
-        
-        float x = startX + col * (cardSize + spacing);
-        float y = startY + row * (cardSize + spacing);
+        sf::Vector2f position = getCardPosition(i);
         
         const Card& cardData = gameCards[i];
-        std::string imagePath = cardData.getSymbol();
+        const std::string& imagePath = symbols.getSymbol(cardData.getPairId());
         
         auto cardSprite = std::make_unique<CardSprite>(
-            cardData.getId(), imagePath, x, y, cardSize
+            cardData.getId(), cardData.getPairId(), position.x, position.y, CardSize
         );
         
-        // Пытаемся загрузить изображение
-        if (!cardSprite->loadImage(imagePath)) {
-            std::cout << "⚠ Не удалось загрузить изображение: " << imagePath << std::endl;
-            // Если не удалось загрузить, используем текстовый символ
+        // Изображение - область общего атласа темы
+        const sf::IntRect* region = themeAtlas ? themeAtlas->findRegion(imagePath) : nullptr;
+        if (region) {
+            cardSprite->setImage(themeAtlas->getTexture(), *region);
+        } else {
+            LOG_WARN("⚠ Изображение не найдено в атласе: " << imagePath);
+            // Если изображения нет, используем текстовый символ
             std::string fallback = "IMG" + std::to_string((i % totalPairs) + 1);
             cardSprite->setSymbol(fallback, mainFont);
         }
         
         cardSprite->setClickable(true);
         cardSprite->hide();
+        cardSprite->setFlipDuration(cardFlipTime);
         
         cards.push_back(std::move(cardSprite));
     }
     
-    std::cout << "✅ Создано " << cards.size() << " спрайтов карт" << std::endl;
+    LOG_DEBUG("✅ Создано " << cards.size() << " спрайтов карт");
+    
+    resetBoardView();
 }
 
 void Game::resetGame() {
-    std::cout << "\n=== СБРОС ИГРЫ ===" << std::endl;
+    TRACE_SCOPE("Game::resetGame");
+    LOG_DEBUG("=== СБРОС ИГРЫ ===");
     
-    // Сбрасываем состояние игры
-    matchedPairs = 0;
-    moves = 0;
+    // Сбрасываем состояние игры (счётчики ходов и пар - в движке)
     isGameActive = false;
-    firstCardSelected = false;
-    selectedCard1 = -1;
-    selectedCard2 = -1;
-    firstCard = nullptr;
-    secondCard = nullptr;
     isChecking = false;
     isFlipping = false;
-    cardFlipProgress = 0.0f;
     hasWon = false;
+    lastTimerSeconds = -1;
+    
+    // Отложенные действия ссылаются на старые карты
+    scheduler.clear();
     
-    std::cout << "matchedPairs сброшен на 0" << std::endl;
-    std::cout << "hasWon сброшен на false" << std::endl;
+    LOG_DEBUG("hasWon сброшен на false");
     
     // Очищаем существующие карты
     cards.clear();
     gameCards.clear();
     
-    std::cout << "Сбрасываем игрока..." << std::endl;
+    LOG_DEBUG("Сбрасываем игрока...");
     if (player) {
         player->startGame();
     }
     
-    std::cout << "Инициализируем новые карты..." << std::endl;
+    LOG_DEBUG("Инициализируем новые карты...");
     initializeCards();
     
-    std::cout << "Создаем спрайты карт..." << std::endl;
+    LOG_DEBUG("Создаем спрайты карт...");
     createCardSprites();
     
     // Проверяем результат
-    std::cout << "Результат инициализации:" << std::endl;
-    std::cout << "  Размер поля: " << rows << "x" << cols << " = " << (rows * cols) << " карт" << std::endl;
-    std::cout << "  Создано спрайтов: " << cards.size() << std::endl;
-    std::cout << "  Всего пар: " << totalPairs << std::endl;
+    LOG_DEBUG("Результат инициализации:");
+    LOG_DEBUG("  Размер поля: " << rows << "x" << cols << " = " << (rows * cols) << " карт");
+    LOG_DEBUG("  Создано спрайтов: " << cards.size());
+    LOG_DEBUG("  Всего пар: " << totalPairs);
     
     if (cards.size() == static_cast<size_t>(rows * cols)) {
-        std::cout << "✅ Инициализация успешна!" << std::endl;
+        LOG_DEBUG("✅ Инициализация успешна!");
     } else {
-        std::cout << "❌ ОШИБКА: Не все спрайты созданы!" << std::endl;
+        LOG_ERROR("❌ ОШИБКА: Не все спрайты созданы!");
     }
     
     // Сбрасываем таймер
-    gameClock.restart();
     elapsedTime = sf::Time::Zero;
     
-    std::cout << "=== СБРОС ЗАВЕРШЕН ===\n" << std::endl;
+    LOG_DEBUG("=== СБРОС ЗАВЕРШЕН ===");
 }
 
 void Game::run() {
-    std::cout << "=== НАЧАЛО ИГРОВОГО ЦИКЛА ===" << std::endl;
+    LOG_INFO("=== НАЧАЛО ИГРОВОГО ЦИКЛА ===");
     sf::Clock clock;
+    sf::Clock phaseClock;
     
     while (window.isOpen()) {
-        sf::Time deltaTime = clock.restart();
+        float frameTime = std::min(clock.restart().asSeconds(), MaxFrameTime);
+        simulationAccumulator += frameTime;
+        currentFrame = FrameSample();
+        currentFrame.frameMs = frameTime * 1000.0f;
         
-        handleEvents();
-        update(deltaTime.asSeconds());
-        render();
-    }
-}
-
-void Game::handleEvents() {
-    sf::Event event;
-    sf::Vector2f mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
-    
-    while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            window.close();
+        phaseClock.restart();
+        {
+            TRACE_SCOPE("Game::handleEvents");
+            handleEvents();
         }
+        currentFrame.eventsMs = phaseClock.getElapsedTime().asMicroseconds() / 1000.0f;
         
-        if (event.type == sf::Event::Resized) {
-            sf::FloatRect visibleArea(0, 0, event.size.width, event.size.height);
-            window.setView(sf::View(visibleArea));
-            updateBackgrounds();
+        // Догружаем атлас темы в текстуру понемногу каждый кадр
+        themeLoader.poll();
+        // Ответы фоновой записи результатов
+        if (persistence) {
+            persistence->poll();
         }
         
-        switch (currentState) {
-            case GameState::MAIN_MENU:
-                for (auto& button : mainMenuButtons) {
-                    button.handleEvent(event, mousePos);
-                }
-                break;
-                
-            case GameState::ENTER_NAME:
-                if (event.type == sf::Event::TextEntered) {
-                    if (event.text.unicode == '\b') {
-                        if (!playerNameInput.empty()) {
-                            playerNameInput.pop_back();
-                        }
-                    } else if (event.text.unicode == '\r') {
-                        if (!playerNameInput.empty()) {
-                            player = std::make_unique<Player>(playerNameInput);
-                            currentState = GameState::SETUP;
-                            isEnteringName = false;
-                            std::cout << "Игрок создан: " << playerNameInput << std::endl;
-                        }
-                    } else if (event.text.unicode >= 32 && event.text.unicode < 128) {
-                        if (playerNameInput.length() < 20) {
-                            playerNameInput += static_cast<char>(event.text.unicode);
-                        }
-                    }
-                }
-                break;
-                
-            case GameState::SETUP:
-                for (auto& button : setupButtons) {
-                    button.handleEvent(event, mousePos);
-                }
-                break;
-                
-            case GameState::PLAYING:
-                if (event.type == sf::Event::MouseButtonPressed) {
-                    if (event.mouseButton.button == sf::Mouse::Left) {
-                        for (size_t i = 0; i < cards.size(); i++) {
-                            if (cards[i]->contains(mousePos) && 
-                                cards[i]->getState() == CardState::HIDDEN &&
-                                cards[i]->getIsClickable() &&
-                                !isFlipping && !isChecking) {
-                                handleCardClick(i);
-                                break;
-                            }
-                        }
-                        
-                        surrenderButton.handleEvent(event, mousePos);
-                    }
-                }
-                for (auto& button : gameButtons) {
-                    button.handleEvent(event, mousePos);
-                }
-                break;
-                
-            case GameState::PAUSED:
-                for (auto& button : pauseButtons) {
-                    button.handleEvent(event, mousePos);
-                }
-                break;
-                
-            case GameState::GAME_OVER_WIN:
-            case GameState::GAME_OVER_LOSE:
-                if (event.type == sf::Event::MouseButtonPressed) {
-                    if (event.mouseButton.button == sf::Mouse::Left) {
-                        if (mousePos.x >= window.getSize().x / 2 - 150 && 
-                            mousePos.x <= window.getSize().x / 2 + 150 &&
-                            mousePos.y >= window.getSize().y - 150 && 
-                            mousePos.y <= window.getSize().y - 90) {
-                            currentState = GameState::MAIN_MENU;
-                            background.setTexture(menuBackgroundTexture);
-                        }
-                    }
-                }
-                break;
-                
-            case GameState::LEADERBOARD:
-                for (auto& button : leaderboardButtons) {
-                    button.handleEvent(event, mousePos);
-                }
-                break;
-                
-            case GameState::SETTINGS:
-                for (auto& button : settingsButtons) {
-                    button.handleEvent(event, mousePos);
-                }
-                break;
-                
-            case GameState::CONTACT_FORM:
-                contactForm.handleEvent(event, mousePos);
-                
-                if (event.type == sf::Event::MouseButtonPressed) {
-                    if (event.mouseButton.button == sf::Mouse::Left) {
-                        if (contactForm.isMouseOverBackButton(mousePos)) {
-                            currentState = previousState;
-                            background.setTexture(menuBackgroundTexture);
-                        }
-                    }
-                }
-                break;
-                
-            case GameState::EXIT:
-                window.close();
-                break;
+        // Логика - целое число тиков, остаток переходит в следующий кадр
+        phaseClock.restart();
+        while (simulationAccumulator >= SimulationStep) {
+            TRACE_SCOPE("Game::update");
+            update(SimulationStep);
+            simulationAccumulator -= SimulationStep;
+            currentFrame.ticks++;
+        }
+        currentFrame.updateMs = phaseClock.getElapsedTime().asMicroseconds() / 1000.0f;
+        renderAlpha = simulationAccumulator / SimulationStep;
+        
+        // Кадр рисуется только если что-то изменилось; без ограничений
+        // и с открытым профилировщиком - каждый раз
+        if (needsRedraw || !animatingCards.empty() || presentMode == PresentMode::UNCAPPED ||
+            profilerOverlay.isVisible()) {
+            needsRedraw = true;
+            render();
+            paceFrame();
+        } else {
+            waitForActivity();
+        }
+        
+        // Окно в фоне - редкие кадры
+        if (!hasFocus) {
+            sf::sleep(sf::seconds(UnfocusedFrameTime));
         }
     }
 }
 
-void Game::update(float deltaTime) {
-    sf::Vector2f mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
+void Game::paceFrame() {
+    if (presentMode != PresentMode::CAPPED) {
+        return;
+    }
     
-    switch (currentState) {
-        case GameState::MAIN_MENU:
-            for (auto& button : mainMenuButtons) button.update(mousePos);
-            break;
-            
-        case GameState::ENTER_NAME:
-            break;
-            
-        case GameState::SETUP:
-            for (auto& button : setupButtons) button.update(mousePos);
-            break;
-            
-        case GameState::PLAYING:
-            if (isGameActive) {
-                elapsedTime = gameClock.getElapsedTime();
-                
-                int seconds = static_cast<int>(elapsedTime.asSeconds());
-                int minutes = seconds / 60;
-                seconds %= 60;
-                std::stringstream timeSS;
-                timeSS << std::setfill('0') << std::setw(2) << minutes << ":"
-                       << std::setfill('0') << std::setw(2) << seconds;
-                timerText.setString("Time: " + timeSS.str());
-                
-                updateStats();
-            }
-            
-            for (auto& button : gameButtons) button.update(mousePos);
-            surrenderButton.update(mousePos);
-            
-            if (isFlipping) {
-                cardFlipProgress += deltaTime;
-                if (cardFlipProgress >= cardFlipTime) {
-                    cardFlipProgress = 0.0f;
-                    isFlipping = false;
-                    
-                    if (firstCard && secondCard) {
-                        isChecking = true;
-                        processCardMatch();
-                    }
-                }
-            }
-            break;
-            
-        case GameState::PAUSED:
-            for (auto& button : pauseButtons) button.update(mousePos);
-            break;
-            
-        case GameState::GAME_OVER_WIN:
-            break;
-            
-        case GameState::GAME_OVER_LOSE:
-            break;
-            
-        case GameState::LEADERBOARD:
-            for (auto& button : leaderboardButtons) button.update(mousePos);
-            break;
-            
-        case GameState::SETTINGS:
-            for (auto& button : settingsButtons) button.update(mousePos);
+    // Срок кадра отсчитывается от прошлого срока, а не от конца работы,
+    // поэтому ошибки сна не накапливаются. Спим до ~1 мс до срока, остаток
+    // добираем короткими снами - длинный sleep на многих системах неточен,
+    // а пустой цикл ожидания занимал бы ядро на каждом кадре
+    sf::Time period = sf::seconds(1.0f / frameRateLimit);
+    sf::Time now = pacingClock.getElapsedTime();
+    nextFrameDeadline += period;
+    if (nextFrameDeadline < now) {
+        // Отстали (долгий кадр или простой) - новый отсчёт
+        nextFrameDeadline = now;
+        return;
+    }
+    
+    sf::Time sleepMargin = sf::milliseconds(1);
+    if (nextFrameDeadline - now > sleepMargin) {
+        sf::sleep(nextFrameDeadline - now - sleepMargin);
+    }
+    while (pacingClock.getElapsedTime() < nextFrameDeadline) {
+        sf::sleep(sf::microseconds(100));
+    }
+}
+
+void Game::applyPresentMode() {
+    switch (presentMode) {
+        case PresentMode::CAPPED:
+            // Частоту держит paceFrame
+            window.setVerticalSyncEnabled(false);
+            window.setFramerateLimit(0);
+            nextFrameDeadline = pacingClock.getElapsedTime();
             break;
-            
-        case GameState::CONTACT_FORM:
-            contactForm.update(mousePos);
+        case PresentMode::VSYNC:
+            window.setFramerateLimit(0);
+            window.setVerticalSyncEnabled(true);
             break;
-            
-        case GameState::EXIT:
+        case PresentMode::UNCAPPED:
+            window.setVerticalSyncEnabled(false);
+            window.setFramerateLimit(0);
             break;
     }
     
-    for (auto& card : cards) {
-        card->update(deltaTime);
+    frameTiming.clear();
+    if (presentMode == PresentMode::CAPPED) {
+        LOG_INFO("Показ кадров: " << getPresentModeName(presentMode) << ", " << frameRateLimit << " FPS");
+    } else {
+        LOG_INFO("Показ кадров: " << getPresentModeName(presentMode));
     }
 }
 
-void Game::render() {
-    window.clear();
+const char* Game::getPresentModeName(PresentMode mode) {
+    switch (mode) {
+        case PresentMode::CAPPED: return "Capped";
+        case PresentMode::VSYNC: return "VSync";
+        case PresentMode::UNCAPPED: return "Uncapped";
+    }
+    return "Capped";
+}
+
+void Game::logFrameTiming() {
+    if (!logFrameStats || frameStatsClock.getElapsedTime().asSeconds() < 5.0f) {
+        return;
+    }
+    frameStatsClock.restart();
+    
+    FrameSample average = frameTiming.getAverage();
+    float budgetMs = getFrameBudgetMs();
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2)
+       << "⏱ Кадр: " << average.frameMs << " мс (p99 " << frameTiming.getFramePercentile(99) << ")"
+       << ", логика " << average.updateMs << " мс за " << average.ticks << " тик."
+       << ", сборка " << average.renderMs << " мс, показ " << average.presentMs << " мс"
+       << ", запас " << frameTiming.getHeadroomMs(budgetMs) << " мс";
+    LOG_INFO(ss.str());
+}
+
+float Game::getFrameBudgetMs() const {
+    // Без своего ограничителя бюджет считается от 60 Гц
+    return presentMode == PresentMode::CAPPED ? 1000.0f / frameRateLimit : 1000.0f / 60.0f;
+}
+
+void Game::dumpFrameTiming() {
+    char name[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(name, sizeof(name), "frame_profile_%Y%m%d_%H%M%S.csv", std::localtime(&now));
+    
+    if (frameTiming.writeCsv(name)) {
+        LOG_INFO("📊 История кадров (" << frameTiming.getCount() << ") сохранена: " << name);
+    } else {
+        LOG_ERROR("❌ Не удалось записать " << name);
+    }
+}
+
+void Game::toggleTrace() {
+    if (Trace::isEnabled()) {
+        Trace::stop();
+        return;
+    }
+    
+    char name[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(name, sizeof(name), "trace_%Y%m%d_%H%M%S.json", std::localtime(&now));
+    Trace::start(name);
+}
+
+void Game::waitForActivity() {
+    float timeout = getIdleTimeout();
+    
+    if (timeout < 0.0f) {
+        // Ничего не запланировано - спим до следующего события окна
+        sf::Event event;
+        if (window.waitEvent(event)) {
+            processEvent(event, static_cast<sf::Vector2f>(sf::Mouse::getPosition(window)));
+        }
+        return;
+    }
+    
+    // Ждём ближайший таймер, но не дольше кадра, чтобы не задерживать ввод
+    sf::sleep(sf::seconds(std::min(timeout, IdleFrameTime)));
+}
+
+float Game::getIdleTimeout() const {
+    ThemeLoader::Status loaderStatus = themeLoader.getStatus();
+    if (currentState == GameState::LOADING ||
+        loaderStatus == ThemeLoader::Status::DECODING ||
+        loaderStatus == ThemeLoader::Status::UPLOADING) {
+        return 0.0f;
+    }
+    
+    // Переворот карт идёт каждый тик
+    if (!animatingCards.empty()) {
+        return 0.0f;
+    }
+    
+    // Ждём ответа о сохранении, чтобы сразу показать его
+    if (persistence && persistence->isBusy()) {
+        return IdleFrameTime;
+    }
+    
+    float timeout = scheduler.getTimeUntilNext();
+    
+    // Таймер на экране меняется раз в секунду
+    if (currentState == GameState::PLAYING && isGameActive) {
+        float elapsed = elapsedTime.asSeconds();
+        float untilNextSecond = 1.0f - (elapsed - std::floor(elapsed));
+        timeout = timeout < 0.0f ? untilNextSecond : std::min(timeout, untilNextSecond);
+    }
+    
+    return timeout;
+}
+
+void Game::handleEvents() {
+    sf::Event event;
+    sf::Vector2f mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
+    
+    while (window.pollEvent(event)) {
+        processEvent(event, mousePos);
+    }
+}
+
+void Game::processEvent(const sf::Event& event, const sf::Vector2f& mousePos) {
+    // Движение мыши само по себе кадр не требует - подсветку кнопок
+    // проверяет update()
+    if (event.type != sf::Event::MouseMoved) {
+        markDirty();
+    }
+    
+    if (event.type == sf::Event::Closed) {
+        window.close();
+    }
+    
+    if (event.type == sf::Event::LostFocus) {
+        hasFocus = false;
+    } else if (event.type == sf::Event::GainedFocus) {
+        hasFocus = true;
+    }
+    
+    if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::F3) {
+            profilerOverlay.toggle();
+        } else if (event.key.code == sf::Keyboard::F4) {
+            dumpFrameTiming();
+        } else if (event.key.code == sf::Keyboard::F5) {
+            toggleTrace();
+        }
+    }
+    
+    if (event.type == sf::Event::Resized) {
+        sf::FloatRect visibleArea(0, 0, event.size.width, event.size.height);
+        window.setView(sf::View(visibleArea));
+        updateBackgrounds();
+        layoutUI();
+    }
+    
+    switch (currentState) {
+        case GameState::MAIN_MENU:
+            for (auto& button : mainMenuButtons) {
+                button.handleEvent(event, mousePos);
+            }
+            break;
+            
+        case GameState::ENTER_NAME:
+            if (event.type == sf::Event::TextEntered) {
+                if (event.text.unicode == '\b') {
+                    if (!playerNameInput.empty()) {
+                        playerNameInput.pop_back();
+                    }
+                } else if (event.text.unicode == '\r') {
+                    if (!playerNameInput.empty()) {
+                        player = std::make_unique<Player>(playerNameInput);
+                        currentState = GameState::SETUP;
+                        prefetchTheme(currentTheme);
+                        isEnteringName = false;
+                        LOG_INFO("Игрок создан: " << playerNameInput);
+                    }
+                } else if (event.text.unicode >= 32 && event.text.unicode < 128) {
+                    if (playerNameInput.length() < 20) {
+                        playerNameInput += static_cast<char>(event.text.unicode);
+                    }
+                }
+                screenRevision++;
+            }
+            break;
+            
+        case GameState::SETUP:
+            for (auto& button : setupButtons) {
+                button.handleEvent(event, mousePos);
+            }
+            
+            // Размер своего поля - стрелками, с Shift шаг 10
+            if (event.type == sf::Event::KeyPressed && difficulty == Difficulty::CUSTOM) {
+                int step = event.key.shift ? 10 : 1;
+                switch (event.key.code) {
+                    case sf::Keyboard::Up: setCustomBoardSize(customRows + step, customCols); break;
+                    case sf::Keyboard::Down: setCustomBoardSize(customRows - step, customCols); break;
+                    case sf::Keyboard::Right: setCustomBoardSize(customRows, customCols + step); break;
+                    case sf::Keyboard::Left: setCustomBoardSize(customRows, customCols - step); break;
+                    default: break;
+                }
+            }
+            break;
+            
+        case GameState::LOADING:
+            break;
+            
+        case GameState::PLAYING:
+            if (handleBoardEvent(event)) {
+                break;
+            }
+            if (event.type == sf::Event::MouseButtonPressed) {
+                if (event.mouseButton.button == sf::Mouse::Left) {
+                    // Кнопки лежат поверх поля - клик по ним карту не открывает
+                    bool overButton = surrenderButton.contains(mousePos);
+                    for (const auto& button : gameButtons) {
+                        overButton = overButton || button.contains(mousePos);
+                    }
+                    
+                    // Карта под курсором - по клетке сетки
+                    int cardIndex = overButton ? -1 : findCardAt(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+                    if (cardIndex >= 0) {
+                        handleCardClick(cardIndex);
+                    }
+                    
+                    surrenderButton.handleEvent(event, mousePos);
+                }
+            }
+            for (auto& button : gameButtons) {
+                button.handleEvent(event, mousePos);
+            }
+            break;
+            
+        case GameState::PAUSED:
+            for (auto& button : pauseButtons) {
+                button.handleEvent(event, mousePos);
+            }
+            break;
+            
+        case GameState::GAME_OVER_WIN:
+        case GameState::GAME_OVER_LOSE:
+            if (event.type == sf::Event::MouseButtonPressed) {
+                if (event.mouseButton.button == sf::Mouse::Left) {
+                    if (mousePos.x >= window.getSize().x / 2 - 150 && 
+                        mousePos.x <= window.getSize().x / 2 + 150 &&
+                        mousePos.y >= window.getSize().y - 150 && 
+                        mousePos.y <= window.getSize().y - 90) {
+                        currentState = GameState::MAIN_MENU;
+                    }
+                }
+            }
+            break;
+            
+        case GameState::LEADERBOARD:
+            for (auto& button : leaderboardButtons) {
+                button.handleEvent(event, mousePos);
+            }
+            break;
+            
+        case GameState::PROFILE:
+            for (auto& button : profileButtons) {
+                button.handleEvent(event, mousePos);
+            }
+            break;
+            
+        case GameState::SETTINGS:
+            for (auto& button : settingsButtons) {
+                button.handleEvent(event, mousePos);
+            }
+            break;
+            
+        case GameState::CONTACT_FORM:
+            contactForm.handleEvent(event, mousePos);
+            
+            if (event.type == sf::Event::MouseButtonPressed) {
+                if (event.mouseButton.button == sf::Mouse::Left) {
+                    if (contactForm.isMouseOverBackButton(mousePos)) {
+                        currentState = previousState;
+                    }
+                }
+            }
+            break;
+            
+        case GameState::EXIT:
+            window.close();
+            break;
+    }
+}
+
+void Game::update(float deltaTime) {
+    sf::Vector2f mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
+    
+    switch (currentState) {
+        case GameState::MAIN_MENU:
+            updateButtons(mainMenuButtons, mousePos);
+            break;
+            
+        case GameState::ENTER_NAME:
+            break;
+            
+        case GameState::SETUP:
+            updateButtons(setupButtons, mousePos);
+            break;
+            
+        case GameState::LOADING: {
+            // Полоса прогресса движется каждый кадр
+            markDirty();
+            
+            std::string imageDir = getThemeImageDir(currentTheme);
+            if (!themeLoader.isLoading(imageDir)) {
+                // Готово, либо загрузка не удалась - тогда initializeCards соберёт атлас сам
+                startPlaying();
+            }
+            break;
+        }
+            
+        case GameState::PLAYING:
+            if (isGameActive) {
+                elapsedTime += sf::seconds(deltaTime);
+            }
+            
+            scheduler.update(deltaTime);
+            
+            // Таймер и статистика меняются раз в секунду или после хода
+            if (isGameActive) {
+                int totalSeconds = static_cast<int>(elapsedTime.asSeconds());
+                if (totalSeconds != lastTimerSeconds || getCardsRevision() != lastCardsRevision) {
+                    lastTimerSeconds = totalSeconds;
+                    
+                    int minutes = totalSeconds / 60;
+                    int seconds = totalSeconds % 60;
+                    std::stringstream timeSS;
+                    timeSS << std::setfill('0') << std::setw(2) << minutes << ":"
+                           << std::setfill('0') << std::setw(2) << seconds;
+                    timerText.setString("Time: " + timeSS.str());
+                    
+                    updateStats();
+                    markDirty();
+                }
+            }
+            
+            updateButtons(gameButtons, mousePos);
+            if (surrenderButton.update(mousePos)) markDirty();
+            break;
+            
+        case GameState::PAUSED:
+            updateButtons(pauseButtons, mousePos);
+            break;
+            
+        case GameState::GAME_OVER_WIN:
+            if (updateContinueButton(sf::Color(0, 200, 0), sf::Color(50, 205, 50))) markDirty();
+            break;
+            
+        case GameState::GAME_OVER_LOSE:
+            if (updateContinueButton(sf::Color(50, 100, 150), sf::Color(70, 130, 180))) markDirty();
+            break;
+            
+        case GameState::LEADERBOARD:
+            updateButtons(leaderboardButtons, mousePos);
+            break;
+            
+        case GameState::PROFILE:
+            updateButtons(profileButtons, mousePos);
+            break;
+            
+        case GameState::SETTINGS:
+            updateButtons(settingsButtons, mousePos);
+            break;
+            
+        case GameState::CONTACT_FORM:
+            if (contactForm.update(mousePos)) markDirty();
+            break;
+            
+        case GameState::EXIT:
+            break;
+    }
+    
+    // Тик получают только переворачивающиеся карты
+    for (std::size_t i = 0; i < animatingCards.size();) {
+        CardSprite& card = *cards[animatingCards[i]];
+        card.update(deltaTime);
+        if (card.isAnimating()) {
+            i++;
+        } else {
+            animatingCards[i] = animatingCards.back();
+            animatingCards.pop_back();
+        }
+    }
+    
+    // Перевороты карт и смена экрана требуют нового кадра
+    unsigned long cardsRevision = getCardsRevision();
+    if (cardsRevision != lastCardsRevision) {
+        lastCardsRevision = cardsRevision;
+        markDirty();
+    }
+    
+    if (currentState != renderedState) {
+        markDirty();
+    }
+}
+
+void Game::updateButtons(std::vector<Button>& buttons, const sf::Vector2f& mousePos) {
+    for (auto& button : buttons) {
+        if (button.update(mousePos)) {
+            markDirty();
+        }
+    }
+}
+
+unsigned long Game::getCardsRevision() const {
+    // Ревизии карт только растут, поэтому сумма меняется при любом изменении.
+    // Невидимые карты кадр не меняют и не учитываются
+    unsigned long revision = 0;
+    for (int row = visibleCells.top; row < visibleCells.top + visibleCells.height; row++) {
+        for (int col = visibleCells.left; col < visibleCells.left + visibleCells.width; col++) {
+            std::size_t index = static_cast<std::size_t>(row) * cols + col;
+            if (index < cards.size()) {
+                revision += cards[index]->getRevision();
+            }
+        }
+    }
+    return revision;
+}
+
+void Game::render() {
+    if (!needsRedraw) {
+        return;
+    }
+    needsRedraw = false;
+    
+    sf::Clock phaseClock;
+    {
+        TRACE_SCOPE("Game::renderFrame");
+        renderFrame();
+    }
+    currentFrame.renderMs = phaseClock.restart().asMicroseconds() / 1000.0f;
+    {
+        TRACE_SCOPE("window.display");
+        window.display();
+    }
+    currentFrame.presentMs = phaseClock.getElapsedTime().asMicroseconds() / 1000.0f;
+    
+    frameTiming.record(currentFrame);
+    logFrameTiming();
+}
+
+void Game::renderFrame() {
+    drawCalls = 0;
+    renderTarget->clear();
+    
+    // Надписи экрана собираются заново при каждом входе в состояние
+    if (currentState != renderedState) {
+        screenText.invalidate();
+        renderedState = currentState;
+    }
     
     if (currentState == GameState::MAIN_MENU || 
         currentState == GameState::SETUP ||
         currentState == GameState::LEADERBOARD ||
+        currentState == GameState::PROFILE ||
         currentState == GameState::ENTER_NAME ||
         currentState == GameState::SETTINGS) {
-        background.setTexture(menuBackgroundTexture);
+        background.setFillColor(menuBackgroundTint);
     } else {
-        background.setTexture(gameBackgroundTexture);
+        background.setFillColor(gameBackgroundTint);
     }
     
-    window.draw(background);
+    draw(background);
     
     switch (currentState) {
         case GameState::MAIN_MENU:
@@ -1068,6 +1705,10 @@ void Game::render() {
             renderSetupMenu();
             break;
             
+        case GameState::LOADING:
+            renderLoading();
+            break;
+            
         case GameState::PLAYING:
             renderGame();
             break;
@@ -1088,6 +1729,10 @@ void Game::render() {
             renderLeaderboard();
             break;
             
+        case GameState::PROFILE:
+            renderProfile();
+            break;
+            
         case GameState::SETTINGS:
             renderSettings();
             break;
@@ -1100,351 +1745,388 @@ void Game::render() {
             break;
     }
     
-    window.display();
+    // Профилировщик поверх любого экрана; скрытый ничего не стоит
+    if (profilerOverlay.isVisible()) {
+        profilerOverlay.update(frameTiming, getFrameBudgetMs());
+        drawCalls += profilerOverlay.draw(*renderTarget);
+    }
 }
 
 void Game::renderContactForm() {
     // Полупрозрачный фон
-    sf::RectangleShape overlay(sf::Vector2f(window.getSize().x, window.getSize().y));
-    overlay.setFillColor(sf::Color(0, 0, 0, 200));
-    window.draw(overlay);
+    if (rebuildScreenText()) {
+        screenOverlay.setSize(sf::Vector2f(window.getSize().x, window.getSize().y));
+        screenOverlay.setFillColor(sf::Color(0, 0, 0, 200));
+    }
+    draw(screenOverlay);
     
-    contactForm.render(window);
+    drawCalls += contactForm.render(*renderTarget);
 }
 
 void Game::renderSettings() {
-    window.draw(settingsTitle);
+    if (rebuildScreenText()) {
+        screenText.add("Changes apply immediately!", mainFont, 20, sf::Color(200, 200, 200))
+            .setPosition(window.getSize().x / 2 - 100, 500);
+    }
+    
+    draw(settingsTitle);
     
     for (auto& button : settingsButtons) {
-        button.render(window);
+        draw(button);
     }
     
-    sf::Text hintText("Changes apply immediately!", mainFont, 20);
-    hintText.setFillColor(sf::Color(200, 200, 200));
-    hintText.setPosition(window.getSize().x / 2 - 100, 500);
-    window.draw(hintText);
+    draw(screenText);
 }
 
 void Game::renderGameOverWin() {
-    std::cout << "=== ОТРИСОВКА ЭКРАНА ПОБЕДЫ ===" << std::endl;
-    std::cout << "Статистика: " << matchedPairs << "/" << totalPairs << " пар" << std::endl;
-    
-    // Поздравление с победой
-    sf::Text victoryText("VICTORY!", mainFont, 72);
-    victoryText.setFillColor(sf::Color(255, 215, 0));
-    victoryText.setStyle(sf::Text::Bold);
-    
-    sf::FloatRect bounds = victoryText.getLocalBounds();
-    victoryText.setOrigin(bounds.left + bounds.width / 2.0f,
-                         bounds.top + bounds.height / 2.0f);
-    victoryText.setPosition(window.getSize().x / 2, 150);
-    window.draw(victoryText);
-    
-    // Поздравительное сообщение
-    sf::Text congratsText("Congratulations!", mainFont, 48);
-    congratsText.setFillColor(sf::Color::Green);
-    congratsText.setStyle(sf::Text::Bold);
-    
-    sf::FloatRect congratsBounds = congratsText.getLocalBounds();
-    congratsText.setOrigin(congratsBounds.left + congratsBounds.width / 2.0f,
-                          congratsBounds.top + congratsBounds.height / 2.0f);
-    congratsText.setPosition(window.getSize().x / 2, 250);
-    window.draw(congratsText);
-    
-    // Статистика
-    if (player) {
-        std::stringstream stats;
-        stats << "Player: " << player->getName() << "\n\n";
-        stats << "Final Score: " << player->getScore() << "\n";
-        stats << "Moves: " << moves << "\n";
-        stats << "Perfect Match: " << (moves == totalPairs ? "YES!" : "No") << "\n";
-        stats << "Time: " << (int)elapsedTime.asSeconds() << " seconds\n";
-        stats << "Difficulty: " << getDifficultyString();
+    if (rebuildScreenText()) {
+        LOG_DEBUG("=== ОТРИСОВКА ЭКРАНА ПОБЕДЫ ===");
+        LOG_DEBUG("Статистика: " << board.getMatchedPairs() << "/" << totalPairs << " пар");
         
-        sf::Text statsText(stats.str(), mainFont, 32);
-        statsText.setFillColor(sf::Color::White);
-        statsText.setPosition(window.getSize().x / 2 - 200, 300);
-        window.draw(statsText);
-    }
-    
-    // Кнопка продолжения
-    sf::RectangleShape continueButton(sf::Vector2f(300, 60));
-    continueButton.setPosition(window.getSize().x / 2 - 150, window.getSize().y - 150);
-    
-    sf::Vector2f mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
-    bool isMouseOverButton = continueButton.getGlobalBounds().contains(mousePos);
-    
-    if (isMouseOverButton) {
-        continueButton.setFillColor(sf::Color(50, 205, 50));
-        continueButton.setOutlineColor(sf::Color::Yellow);
-    } else {
-        continueButton.setFillColor(sf::Color(0, 200, 0));
-        continueButton.setOutlineColor(sf::Color::White);
+        // Поздравление с победой
+        screenText.addCentered("VICTORY!", mainFont, 72, sf::Color(255, 215, 0),
+                               sf::Vector2f(window.getSize().x / 2, 150), sf::Text::Bold);
+        
+        // Поздравительное сообщение
+        screenText.addCentered("Congratulations!", mainFont, 48, sf::Color::Green,
+                               sf::Vector2f(window.getSize().x / 2, 250), sf::Text::Bold);
+        
+        // Статистика
+        if (player) {
+            std::stringstream stats;
+            stats << "Player: " << player->getName() << "\n\n";
+            stats << "Final Score: " << player->getScore() << "\n";
+            stats << "Moves: " << board.getMoves() << "\n";
+            stats << "Perfect Match: " << (board.getMoves() == totalPairs ? "YES!" : "No") << "\n";
+            stats << "Time: " << (int)elapsedTime.asSeconds() << " seconds\n";
+            stats << "Difficulty: " << getDifficultyString();
+            
+            screenText.add(stats.str(), mainFont, 32, sf::Color::White)
+                .setPosition(window.getSize().x / 2 - 200, 300);
+        }
+        
+        addSaveStatusText();
+        
+        // Кнопка продолжения и надпись с тенью
+        continueButton.setSize(sf::Vector2f(300, 60));
+        continueButton.setPosition(window.getSize().x / 2 - 150, window.getSize().y - 150);
+        continueButton.setOutlineThickness(2);
+        
+        screenText.addCentered("Continue to Menu", mainFont, 28, sf::Color::White,
+                               sf::Vector2f(window.getSize().x / 2, window.getSize().y - 120));
+        screenText.addShadow(sf::Color(0, 0, 0, 150), sf::Vector2f(2, 2));
+        
+        updateContinueButton(sf::Color(0, 200, 0), sf::Color(50, 205, 50));
+        LOG_DEBUG("✅ Экран победы отрисован");
     }
     
-    continueButton.setOutlineThickness(2);
-    window.draw(continueButton);
-    
-    sf::Text continueText("Continue to Menu", mainFont, 28);
-    continueText.setFillColor(sf::Color::White);
-    sf::FloatRect continueBounds = continueText.getLocalBounds();
-    continueText.setOrigin(continueBounds.left + continueBounds.width / 2.0f,
-                          continueBounds.top + continueBounds.height / 2.0f);
-    continueText.setPosition(window.getSize().x / 2, window.getSize().y - 120);
-    
-    // Тень
-    sf::Text shadowText = continueText;
-    shadowText.setFillColor(sf::Color(0, 0, 0, 150));
-    shadowText.move(2, 2);
-    window.draw(shadowText);
-    
-    window.draw(continueText);
-    
-    std::cout << "✅ Экран победы отрисован" << std::endl;
+    draw(continueButton);
+    draw(screenText);
 }
 
 void Game::renderGameOverLose() {
-    // Game Over текст
-    sf::Text gameOverText("GAME OVER", mainFont, 72);
-    gameOverText.setFillColor(sf::Color::Red);
-    gameOverText.setStyle(sf::Text::Bold);
-    
-    sf::FloatRect bounds = gameOverText.getLocalBounds();
-    gameOverText.setOrigin(bounds.left + bounds.width / 2.0f,
-                          bounds.top + bounds.height / 2.0f);
-    gameOverText.setPosition(window.getSize().x / 2, 200);
-    window.draw(gameOverText);
-    
-    // Сообщение
-    sf::Text messageText("Better luck next time!", mainFont, 36);
-    messageText.setFillColor(sf::Color(200, 200, 200));
-    
-    sf::FloatRect messageBounds = messageText.getLocalBounds();
-    messageText.setOrigin(messageBounds.left + messageBounds.width / 2.0f,
-                         messageBounds.top + messageBounds.height / 2.0f);
-    messageText.setPosition(window.getSize().x / 2, 300);
-    window.draw(messageText);
-    
-    // Статистика
-    if (player) {
-        std::stringstream stats;
-        stats << "Player: " << player->getName() << "\n\n";
-        stats << "Final Score: " << player->getScore() << "\n";
-        stats << "Progress: " << matchedPairs << "/" << totalPairs << " pairs\n";
-        stats << "Time: " << (int)elapsedTime.asSeconds() << " seconds\n";
-        stats << "Difficulty: " << getDifficultyString();
+    if (rebuildScreenText()) {
+        // Game Over текст
+        screenText.addCentered("GAME OVER", mainFont, 72, sf::Color::Red,
+                               sf::Vector2f(window.getSize().x / 2, 200), sf::Text::Bold);
+        
+        // Сообщение
+        screenText.addCentered("Better luck next time!", mainFont, 36, sf::Color(200, 200, 200),
+                               sf::Vector2f(window.getSize().x / 2, 300));
+        
+        // Статистика
+        if (player) {
+            std::stringstream stats;
+            stats << "Player: " << player->getName() << "\n\n";
+            stats << "Final Score: " << player->getScore() << "\n";
+            stats << "Progress: " << board.getMatchedPairs() << "/" << totalPairs << " pairs\n";
+            stats << "Time: " << (int)elapsedTime.asSeconds() << " seconds\n";
+            stats << "Difficulty: " << getDifficultyString();
+            
+            screenText.add(stats.str(), mainFont, 32, sf::Color::White)
+                .setPosition(window.getSize().x / 2 - 200, 350);
+        }
         
-        sf::Text statsText(stats.str(), mainFont, 32);
-        statsText.setFillColor(sf::Color::White);
-        statsText.setPosition(window.getSize().x / 2 - 200, 350);
-        window.draw(statsText);
+        addSaveStatusText();
+        
+        // Кнопка продолжения и надпись с тенью
+        continueButton.setSize(sf::Vector2f(300, 60));
+        continueButton.setPosition(window.getSize().x / 2 - 150, window.getSize().y - 150);
+        continueButton.setOutlineThickness(2);
+        
+        screenText.addCentered("Return to Menu", mainFont, 28, sf::Color::White,
+                               sf::Vector2f(window.getSize().x / 2, window.getSize().y - 120));
+        screenText.addShadow(sf::Color(0, 0, 0, 150), sf::Vector2f(2, 2));
+        updateContinueButton(sf::Color(50, 100, 150), sf::Color(70, 130, 180));
     }
     
-    // Кнопка продолжения
-    sf::RectangleShape continueButton(sf::Vector2f(300, 60));
-    continueButton.setPosition(window.getSize().x / 2 - 150, window.getSize().y - 150);
-    
+    draw(continueButton);
+    draw(screenText);
+}
+
+bool Game::updateContinueButton(const sf::Color& idle, const sf::Color& hover) {
     sf::Vector2f mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
-    bool isMouseOverButton = continueButton.getGlobalBounds().contains(mousePos);
+    bool isHovered = continueButton.getGlobalBounds().contains(mousePos);
     
-    if (isMouseOverButton) {
-        continueButton.setFillColor(sf::Color(70, 130, 180));
-        continueButton.setOutlineColor(sf::Color::Yellow);
-    } else {
-        continueButton.setFillColor(sf::Color(50, 100, 150));
-        continueButton.setOutlineColor(sf::Color::White);
+    sf::Color fillColor = isHovered ? hover : idle;
+    if (continueButton.getFillColor() == fillColor) {
+        return false;
     }
     
-    continueButton.setOutlineThickness(2);
-    window.draw(continueButton);
-    
-    sf::Text continueText("Return to Menu", mainFont, 28);
-    continueText.setFillColor(sf::Color::White);
-    sf::FloatRect continueBounds = continueText.getLocalBounds();
-    continueText.setOrigin(continueBounds.left + continueBounds.width / 2.0f,
-                          continueBounds.top + continueBounds.height / 2.0f);
-    continueText.setPosition(window.getSize().x / 2, window.getSize().y - 120);
-    
-    // Тень
-    sf::Text shadowText = continueText;
-    shadowText.setFillColor(sf::Color(0, 0, 0, 150));
-    shadowText.move(2, 2);
-    window.draw(shadowText);
-    
-    window.draw(continueText);
+    continueButton.setFillColor(fillColor);
+    continueButton.setOutlineColor(isHovered ? sf::Color::Yellow : sf::Color::White);
+    return true;
 }
 
 void Game::renderGame() {
     // Заголовок и статистика
-    window.draw(titleText);
-    window.draw(statsText);
-    window.draw(timerText);
-    window.draw(scoreText);
-    window.draw(difficultyText);
-    
-    // Карточки
-    for (auto& card : cards) {
-        card->render(window);
-    }
+    draw(titleText);
+    draw(statsText);
+    draw(timerText);
+    draw(scoreText);
+    draw(difficultyText);
+    
+    // Карточки - одним пакетом, только видимая часть поля в его виде
+    sf::View hudView = renderTarget->getView();
+    renderTarget->setView(boardView);
+    boardRenderer.update(cards, cols, visibleCells, renderAlpha);
+    drawCalls += boardRenderer.render(*renderTarget, cards);
+    renderTarget->setView(hudView);
     
     // Кнопки
     for (auto& button : gameButtons) {
-        button.render(window);
+        draw(button);
     }
     
-    surrenderButton.render(window);
+    draw(surrenderButton);
 }
 
 void Game::renderMainMenu() {
-    window.draw(titleText);
+    draw(titleText);
     
     for (auto& button : mainMenuButtons) {
-        button.render(window);
+        draw(button);
     }
 }
 
 void Game::renderPauseMenu() {
-    // Полупрозрачный фон
-    sf::RectangleShape overlay(sf::Vector2f(window.getSize().x, window.getSize().y));
-    overlay.setFillColor(sf::Color(0, 0, 0, 150));
-    window.draw(overlay);
-    
-    sf::Text pauseText("PAUSED", mainFont, 72);
-    pauseText.setFillColor(sf::Color::Yellow);
-    pauseText.setStyle(sf::Text::Bold);
-    sf::FloatRect pauseBounds = pauseText.getLocalBounds();
-    pauseText.setOrigin(pauseBounds.left + pauseBounds.width / 2.0f,
-                        pauseBounds.top + pauseBounds.height / 2.0f);
-    pauseText.setPosition(window.getSize().x / 2, 200);
-    window.draw(pauseText);
+    if (rebuildScreenText()) {
+        // Полупрозрачный фон
+        screenOverlay.setSize(sf::Vector2f(window.getSize().x, window.getSize().y));
+        screenOverlay.setFillColor(sf::Color(0, 0, 0, 150));
+        
+        screenText.addCentered("PAUSED", mainFont, 72, sf::Color::Yellow,
+                               sf::Vector2f(window.getSize().x / 2, 200), sf::Text::Bold);
+    }
+    
+    draw(screenOverlay);
+    draw(screenText);
     
     for (auto& button : pauseButtons) {
-        button.render(window);
+        draw(button);
     }
 }
 
 void Game::renderSetupMenu() {
-    // Заголовок
-    sf::Text setupTitle("Game Setup", mainFont, 48);
-    setupTitle.setFillColor(sf::Color::White);
-    setupTitle.setStyle(sf::Text::Bold);
-    setupTitle.setPosition(window.getSize().x / 2 - 100, 100);
-    window.draw(setupTitle);
-    
-    // Информация о текущих настройках
-    std::stringstream settingsInfo;
-    settingsInfo << "Current settings:\n";
-    settingsInfo << "• Player: " << (player ? player->getName() : "Not set") << "\n";
-    settingsInfo << "• Difficulty: " << getDifficultyString() << "\n";
-    settingsInfo << "• Theme: ";
-    switch (currentTheme) {
-        case CardTheme::ANIMALS: settingsInfo << "Animals"; break;
-        case CardTheme::FRUITS: settingsInfo << "Fruits"; break;
-        case CardTheme::EMOJI: settingsInfo << "Emoji"; break;
-        case CardTheme::MEMES: settingsInfo << "Memes"; break;
-        case CardTheme::SYMBOLS: settingsInfo << "Symbols"; break;
-    }
-    
-    sf::Text infoText(settingsInfo.str(), mainFont, 24);
-    infoText.setFillColor(sf::Color(200, 200, 200));
-    infoText.setPosition(window.getSize().x / 2 - 200, 150);
-    window.draw(infoText);
+    if (rebuildScreenText()) {
+        // Заголовок
+        screenText.add("Game Setup", mainFont, 48, sf::Color::White, sf::Text::Bold)
+            .setPosition(window.getSize().x / 2 - 100, 100);
+        
+        // Информация о текущих настройках
+        std::stringstream settingsInfo;
+        settingsInfo << "Current settings:\n";
+        settingsInfo << "• Player: " << (player ? player->getName() : "Not set") << "\n";
+        settingsInfo << "• Difficulty: " << getDifficultyString() << "\n";
+        if (difficulty == Difficulty::CUSTOM) {
+            settingsInfo << "  (arrows: rows/cols, Shift: x10)\n";
+        }
+        settingsInfo << "• Theme: " << getThemeName(currentTheme);
+        
+        screenText.add(settingsInfo.str(), mainFont, 24, sf::Color(200, 200, 200))
+            .setPosition(window.getSize().x / 2 - 200, 150);
+    }
+    
+    draw(screenText);
     
     // Кнопки
-    for (auto& button : setupButtons) button.render(window);
+    for (auto& button : setupButtons) draw(button);
+}
+
+void Game::renderLoading() {
+    // Полоса прогресса
+    float barWidth = 400.0f;
+    float barHeight = 30.0f;
+    
+    if (rebuildScreenText()) {
+        screenText.addCentered("Loading theme...", mainFont, 48, sf::Color::White,
+                               sf::Vector2f(window.getSize().x / 2, window.getSize().y / 2 - 60), sf::Text::Bold);
+        
+        float barX = window.getSize().x / 2 - barWidth / 2;
+        float barY = window.getSize().y / 2;
+        
+        loadingBarBackground.setSize(sf::Vector2f(barWidth, barHeight));
+        loadingBarBackground.setPosition(barX, barY);
+        loadingBarBackground.setFillColor(sf::Color(50, 50, 50));
+        loadingBarBackground.setOutlineThickness(2);
+        loadingBarBackground.setOutlineColor(sf::Color::White);
+        
+        loadingBarFill.setPosition(barX, barY);
+        loadingBarFill.setFillColor(sf::Color(0, 200, 0));
+    }
+    
+    draw(screenText);
+    draw(loadingBarBackground);
+    
+    loadingBarFill.setSize(sf::Vector2f(barWidth * themeLoader.getProgress(), barHeight));
+    draw(loadingBarFill);
 }
 
 void Game::renderLeaderboard() {
-    // Заголовок
-    sf::Text title("Leaderboard", mainFont, 64);
-    title.setFillColor(sf::Color::White);
-    title.setStyle(sf::Text::Bold);
-    title.setPosition(window.getSize().x / 2 - 150, 80);
-    window.draw(title);
-    
-    // Получаем лучшие результаты
-    auto topPlayers = database ? database->getTopScores(10) : std::vector<GameRecord>();
-    
-    if (topPlayers.empty()) {
-        sf::Text noData("No records in leaderboard yet", mainFont, 32);
-        noData.setFillColor(sf::Color(200, 200, 200));
-        noData.setPosition(window.getSize().x / 2 - 150, 200);
-        window.draw(noData);
-    } else {
-        // Заголовок таблицы
-        sf::Text header("#  Player              Score   Time   Difficulty", mainFont, 28);
-        header.setFillColor(sf::Color::Yellow);
-        header.setPosition(150, 180);
-        window.draw(header);
+    // Таблица перестраивается только после записи нового результата
+    if (leaderboard.isStale(database.get())) {
+        screenRevision++;
+    }
+    
+    if (rebuildScreenText()) {
+        // Заголовок
+        screenText.add("Leaderboard", mainFont, 64, sf::Color::White, sf::Text::Bold)
+            .setPosition(window.getSize().x / 2 - 150, 80);
         
-        // Список
-        float yPos = 230;
-        int rank = 1;
+        // Получаем лучшие результаты
+        const auto& topPlayers = leaderboard.getTopScores(database.get());
         
-        for (const auto& record : topPlayers) {
-            std::stringstream line;
-            line << std::setw(2) << std::right << rank << ". ";
-            line << std::setw(15) << std::left << record.playerName.substr(0, 15) << " ";
-            line << std::setw(6) << std::right << record.score << " ";
-            line << std::setw(4) << std::right << (int)record.time << "s ";
-            line << record.difficulty;
-            
-            sf::Text playerText(line.str(), mainFont, 24);
-            
-            if (rank == 1) playerText.setFillColor(sf::Color(255, 215, 0));
-            else if (rank == 2) playerText.setFillColor(sf::Color(192, 192, 192));
-            else if (rank == 3) playerText.setFillColor(sf::Color(205, 127, 50));
-            else playerText.setFillColor(sf::Color::White);
-            
-            playerText.setPosition(150, yPos);
-            window.draw(playerText);
-            
-            yPos += 40;
-            rank++;
-            if (rank > 10) break;
+        if (topPlayers.empty()) {
+            screenText.add("No records in leaderboard yet", mainFont, 32, sf::Color(200, 200, 200))
+                .setPosition(window.getSize().x / 2 - 150, 200);
+        } else {
+            // Заголовок таблицы
+            screenText.add("#  Player              Score   Time   Difficulty", mainFont, 28, sf::Color::Yellow)
+                .setPosition(150, 180);
+            
+            // Список
+            float yPos = 230;
+            int rank = 1;
+            
+            for (const auto& record : topPlayers) {
+                std::stringstream line;
+                line << std::setw(2) << std::right << rank << ". ";
+                line << std::setw(15) << std::left << record.playerName.substr(0, 15) << " ";
+                line << std::setw(6) << std::right << record.score << " ";
+                line << std::setw(4) << std::right << (int)record.time << "s ";
+                line << record.difficulty;
+                
+                sf::Color color = sf::Color::White;
+                if (rank == 1) color = sf::Color(255, 215, 0);
+                else if (rank == 2) color = sf::Color(192, 192, 192);
+                else if (rank == 3) color = sf::Color(205, 127, 50);
+                
+                screenText.add(line.str(), mainFont, 24, color).setPosition(150, yPos);
+                
+                yPos += 40;
+                rank++;
+                if (rank > leaderboard.getLimit()) break;
+            }
         }
     }
     
+    draw(screenText);
+    
     // Кнопки
-    for (auto& button : leaderboardButtons) button.render(window);
+    for (auto& button : leaderboardButtons) draw(button);
+}
+
+void Game::renderProfile() {
+    // Одна строка player_stats и по строке на сложность - перечитываем
+    // только после записи нового результата
+    unsigned long version = database ? database->getVersion() : 0;
+    if (version != profileVersion) {
+        hasProfileStats = database && player && database->getPlayerStats(player->getName(), profileStats);
+        profileVersion = version;
+        screenRevision++;
+    }
+    
+    if (rebuildScreenText()) {
+        screenText.add("Profile", mainFont, 64, sf::Color::White, sf::Text::Bold)
+            .setPosition(window.getSize().x / 2 - 100, 80);
+        
+        if (!player) {
+            screenText.add("Start a game to create your profile", mainFont, 32, sf::Color(200, 200, 200))
+                .setPosition(window.getSize().x / 2 - 250, 200);
+        } else if (!hasProfileStats) {
+            screenText.add(player->getName() + ": no finished games yet", mainFont, 32, sf::Color(200, 200, 200))
+                .setPosition(window.getSize().x / 2 - 250, 200);
+        } else {
+            std::stringstream summary;
+            summary << std::fixed << std::setprecision(0);
+            summary << "Player: " << profileStats.playerName << "\n\n";
+            summary << "Games played: " << profileStats.games << "\n";
+            summary << "Best score: " << profileStats.bestScore << "\n";
+            summary << "Average score: " << profileStats.meanScore
+                    << " (+/- " << profileStats.scoreStdDev << ")\n";
+            summary << "Last played: " << profileStats.lastPlayed;
+            
+            screenText.add(summary.str(), mainFont, 28, sf::Color::White)
+                .setPosition(150, 180);
+            
+            // Лучшие результаты по сложностям
+            screenText.add("Difficulty       Games   Best", mainFont, 28, sf::Color::Yellow)
+                .setPosition(window.getSize().x / 2 + 50, 180);
+            
+            float yPos = 230;
+            for (const auto& best : profileStats.difficulties) {
+                std::stringstream line;
+                line << std::setw(15) << std::left << best.difficulty.substr(0, 15) << " "
+                     << std::setw(6) << std::right << best.games << " "
+                     << std::setw(6) << best.bestScore;
+                screenText.add(line.str(), mainFont, 24, sf::Color::White)
+                    .setPosition(window.getSize().x / 2 + 50, yPos);
+                yPos += 40;
+            }
+        }
+    }
+    
+    draw(screenText);
+    
+    for (auto& button : profileButtons) draw(button);
 }
 
 void Game::renderNameInput() {
-    // Заголовок
-    sf::Text title;
-    title.setFont(mainFont);
-    title.setString("Enter your name:");
-    title.setCharacterSize(48);
-    title.setFillColor(sf::Color::White);
-    title.setStyle(sf::Text::Bold);
-    
-    sf::FloatRect titleBounds = title.getLocalBounds();
-    title.setOrigin(titleBounds.left + titleBounds.width / 2.0f,
-                    titleBounds.top + titleBounds.height / 2.0f);
-    title.setPosition(window.getSize().x / 2, 200);
-    window.draw(title);
-    
-    // Поле ввода
-    nameInputBox.setPosition(window.getSize().x / 2 - 200, 300);
-    window.draw(nameInputBox);
-    
-    // Текст ввода
-    nameInputText.setString(playerNameInput + "_");
-    nameInputText.setPosition(window.getSize().x / 2 - 180, 315);
-    window.draw(nameInputText);
-    
-    // Подсказка
-    sf::Text hint;
-    hint.setFont(mainFont);
-    hint.setString("Press Enter to continue");
-    hint.setCharacterSize(24);
-    hint.setFillColor(sf::Color(200, 200, 200));
-    
-    sf::FloatRect hintBounds = hint.getLocalBounds();
-    hint.setOrigin(hintBounds.left + hintBounds.width / 2.0f,
-                   hintBounds.top + hintBounds.height / 2.0f);
-    hint.setPosition(window.getSize().x / 2, 400);
-    window.draw(hint);
+    if (rebuildScreenText()) {
+        // Заголовок
+        screenText.addCentered("Enter your name:", mainFont, 48, sf::Color::White,
+                               sf::Vector2f(window.getSize().x / 2, 200), sf::Text::Bold);
+        
+        // Подсказка
+        screenText.addCentered("Press Enter to continue", mainFont, 24, sf::Color(200, 200, 200),
+                               sf::Vector2f(window.getSize().x / 2, 400));
+        
+        // Поле и текст ввода
+        nameInputBox.setPosition(window.getSize().x / 2 - 200, 300);
+        nameInputText.setString(playerNameInput + "_");
+        nameInputText.setPosition(window.getSize().x / 2 - 180, 315);
+    }
+    
+    draw(screenText);
+    draw(nameInputBox);
+    draw(nameInputText);
+}
+
+void Game::draw(const sf::Drawable& drawable) {
+    renderTarget->draw(drawable);
+    drawCalls++;
+}
+
+void Game::draw(Button& button) {
+    drawCalls += button.render(*renderTarget);
+}
+
+void Game::draw(const TextCache& texts) {
+    drawCalls += texts.draw(*renderTarget);
+}
+
+bool Game::rebuildScreenText() {
+    return screenText.needsRebuild(static_cast<int>(currentState), window.getSize(), screenRevision);
 }
 
 void Game::updateStats() {
@@ -1452,15 +2134,15 @@ void Game::updateStats() {
     statsSS << "Player: " << (player ? player->getName() : "Guest") << "\n"
             << "Difficulty: " << getDifficultyString() << "\n"
             << "Field: " << rows << "x" << cols << " (" << (rows * cols) << " cards)\n"
-            << "Moves: " << moves << "\n"
-            << "Pairs found: " << matchedPairs << "/" << totalPairs << "\n"
+            << "Moves: " << board.getMoves() << "\n"
+            << "Pairs found: " << board.getMatchedPairs() << "/" << totalPairs << "\n"
             << "Progress: " << std::fixed << std::setprecision(1) 
-            << (totalPairs > 0 ? (matchedPairs * 100.0 / totalPairs) : 0) << "%";
+            << (totalPairs > 0 ? (board.getMatchedPairs() * 100.0 / totalPairs) : 0) << "%";
     
     statsText.setString(statsSS.str());
     
     if (player) {
-        player->calculateScore(totalPairs);
+        player->calculateScore(totalPairs, getGameSeconds());
         scoreText.setString("Score: " + std::to_string(player->getScore()));
     }
     
@@ -1478,6 +2160,8 @@ sf::Color Game::getDifficultyColor() const {
             return sf::Color(255, 165, 0);
         case Difficulty::EXPERT:
             return sf::Color::Red;
+        case Difficulty::CUSTOM:
+            return sf::Color::Cyan;
         default:
             return sf::Color::White;
     }
@@ -1488,15 +2172,9 @@ void Game::handleCardClick(int cardIndex) {
         return;
     }
     
-    if (cardIndex < 0 || cardIndex >= static_cast<int>(cards.size())) {
-        return;
-    }
-    
-    if (!cards[cardIndex]) {
-        return;
-    }
-    
-    if (cards[cardIndex]->getState() == CardState::HIDDEN && !cards[cardIndex]->getIsClickable()) {
+    // Правила хода проверяет движок
+    BoardEngine::SelectResult result = board.selectCard(cardIndex);
+    if (result == BoardEngine::SelectResult::IGNORED) {
         return;
     }
     
@@ -1505,83 +2183,72 @@ void Game::handleCardClick(int cardIndex) {
         soundManager->playCardFlip();
     }
     
-    // Переворачиваем карту
-    cards[cardIndex]->reveal();
-    cards[cardIndex]->setClickable(false);
+    syncCardSprite(cardIndex);
+    isFlipping = true;
+    
+    // Время выбора - игровое, как у очков и итога повтора (без пауз)
+    replayWriter.recordSelect(cardIndex, static_cast<std::uint32_t>(elapsedTime.asMilliseconds()));
     
-    if (!firstCardSelected) {
-        // Первая карта
-        firstCardSelected = true;
-        selectedCard1 = cardIndex;
-        firstCard = cards[cardIndex].get();
-        isFlipping = true;
-        cardFlipProgress = 0.0f;
+    if (result == BoardEngine::SelectResult::FIRST) {
+        scheduler.schedule(cardFlipTime, [this]() {
+            isFlipping = false;
+        });
     } else {
-        // Вторая карта
-        selectedCard2 = cardIndex;
-        secondCard = cards[cardIndex].get();
-        isFlipping = true;
-        cardFlipProgress = 0.0f;
-        
-        // Увеличиваем счетчик ходов
-        moves++;
         if (player) {
             player->incrementMoves();
         }
         
-        firstCardSelected = false;
+        // Сравниваем после окончания переворота второй карты
+        scheduler.schedule(cardFlipTime, [this]() {
+            isFlipping = false;
+            isChecking = true;
+            processCardMatch();
+        });
     }
 }
 
 void Game::processCardMatch() {
-    std::cout << "=== ПРОВЕРКА СОВПАДЕНИЯ КАРТ ===" << std::endl;
-    std::cout << "Найдено пар: " << matchedPairs << "/" << totalPairs << std::endl;
+    LOG_DEBUG("=== ПРОВЕРКА СОВПАДЕНИЯ КАРТ ===");
     
-    if (!firstCard || !secondCard || !isChecking) {
-        std::cout << "Ошибка: карты не инициализированы" << std::endl;
+    int first = board.getFirstSelected();
+    int second = board.getSecondSelected();
+    BoardEngine::Outcome outcome = board.resolve();
+    
+    if (outcome == BoardEngine::Outcome::NONE) {
+        LOG_WARN("Ошибка: пара карт не выбрана");
+        isChecking = false;
         return;
     }
     
-    // Проверяем совпадение
-    bool match = (firstCard->getSymbol() == secondCard->getSymbol());
-    std::cout << "Символ 1: '" << firstCard->getSymbol() << "'" << std::endl;
-    std::cout << "Символ 2: '" << secondCard->getSymbol() << "'" << std::endl;
-    std::cout << "Совпадение: " << (match ? "ДА" : "НЕТ") << std::endl;
+    LOG_DEBUG("Пары: " << board.getPairId(first) << " и " << board.getPairId(second));
     
-    if (match) {
+    if (outcome == BoardEngine::Outcome::MATCH) {
         // Совпадение
         if (soundManager) {
             soundManager->playCardMatch();
         }
         
-        // Помечаем как совпавшие
-        firstCard->markMatched();
-        secondCard->markMatched();
+        syncCardSprite(first);
+        syncCardSprite(second);
+        isChecking = false;
         
-        // Увеличиваем счетчик совпавших пар
-        matchedPairs++;
-        std::cout << "✅ НОВАЯ ПАРА НАЙДЕНА! Всего: " << matchedPairs << "/" << totalPairs << std::endl;
+        LOG_DEBUG("✅ НОВАЯ ПАРА НАЙДЕНА! Всего: " << board.getMatchedPairs() << "/" << totalPairs);
         
         if (player) {
             player->incrementMatchedPairs();
-        }
-        
-        // Обновляем счет
-        if (player) {
-            player->calculateScore(totalPairs);
+            player->calculateScore(totalPairs, getGameSeconds());
         }
         
         // ===== ПРОВЕРКА ПОБЕДЫ =====
-        if (matchedPairs >= totalPairs && !hasWon) {
-            std::cout << "🎉🎉🎉 ПОБЕДА! ВСЕ ПАРЫ НАЙДЕНЫ! 🎉🎉🎉" << std::endl;
-            std::cout << "Условие: " << matchedPairs << " >= " << totalPairs << std::endl;
+        if (board.isComplete() && !hasWon) {
+            LOG_DEBUG("🎉🎉🎉 ПОБЕДА! ВСЕ ПАРЫ НАЙДЕНЫ! 🎉🎉🎉");
             
             hasWon = true;
             isGameActive = false;
             
             if (player) {
-                player->finishGame();
-                player->calculateScore(totalPairs);
+                player->calculateScore(totalPairs, getGameSeconds());
+                finishReplay(ReplayResult::WON);
                 saveGameResult();
             }
             
@@ -1590,8 +2257,7 @@ void Game::processCardMatch() {
             }
             
             currentState = GameState::GAME_OVER_WIN;
-            std::cout << "Состояние изменено на GAME_OVER_WIN" << std::endl;
-            return;
+            LOG_DEBUG("Состояние изменено на GAME_OVER_WIN");
         }
     } else {
         // Несовпадение
@@ -1599,49 +2265,107 @@ void Game::processCardMatch() {
             soundManager->playCardMismatch();
         }
         
-        isChecking = false;
-        
-        // Небольшая задержка
-        sf::Clock delayClock;
-        while (delayClock.getElapsedTime().asSeconds() < 0.8f) {
-            // Ждем
-        }
-        
-        firstCard->hide();
-        secondCard->hide();
-        firstCard->setClickable(true);
-        secondCard->setClickable(true);
-        std::cout << "❌ Карты не совпали, переворачиваем обратно" << std::endl;
-    }
-    
-    // Сбрасываем выбор только если не победили
-    if (currentState != GameState::GAME_OVER_WIN) {
-        firstCard = nullptr;
-        secondCard = nullptr;
-        selectedCard1 = -1;
-        selectedCard2 = -1;
-        isChecking = false;
+        // Карты остаются открытыми mismatchDelay секунд; клики блокирует
+        // isChecking, а цикл продолжает обрабатывать события и рисовать
+        scheduler.schedule(mismatchDelay, [this, first, second]() {
+            board.hideMismatch();
+            syncCardSprite(first);
+            syncCardSprite(second);
+            isChecking = false;
+            LOG_DEBUG("❌ Карты не совпали, переворачиваем обратно");
+        });
     }
     
-    std::cout << "=== ПРОВЕРКА ЗАВЕРШЕНА ===\n" << std::endl;
+    LOG_DEBUG("=== ПРОВЕРКА ЗАВЕРШЕНА ===");
+}
+
+void Game::syncCardSprite(int index) {
+    // Спрайт показывает состояние карты из движка
+    CardSprite& sprite = *cards[index];
+    
+    if (board.isMatched(index)) {
+        sprite.markMatched();
+    } else if (board.isFaceUp(index)) {
+        sprite.reveal();
+    } else {
+        sprite.hide();
+    }
+    
+    sprite.setClickable(board.canSelect(index));
+    
+    if (sprite.isAnimating() &&
+        std::find(animatingCards.begin(), animatingCards.end(), index) == animatingCards.end()) {
+        animatingCards.push_back(index);
+    }
 }
 
 void Game::saveGameResult() {
-    if (!player || !database) {
+    if (!player) {
         return;
     }
     
     GameRecord record;
     record.playerName = player->getName();
     record.score = player->getScore();
-    record.moves = moves;
-    record.pairs = matchedPairs;
+    record.moves = board.getMoves();
+    record.pairs = board.getMatchedPairs();
     record.time = elapsedTime.asSeconds();
     record.date = getCurrentDate();
     record.difficulty = getDifficultyString();
+    record.seed = dealSeed;
+    record.theme = getThemeName(currentTheme);
+    record.replay = replayName;
     
-    database->saveGame(record);
-    std::cout << "💾 Результат сохранен в БД" << std::endl;
+    queueSave(record);
+}
+
+void Game::queueSave(const GameRecord& record) {
+    if (!persistence) {
+        saveStatus = SaveStatus::NONE;
+        return;
+    }
+    
+    // Запись уходит в фоновый поток; экран итогов обновится по ответу
+    saveStatus = SaveStatus::SAVING;
+    unsigned int generation = ++saveGeneration;
+    persistence->saveGame(record, [this, generation](bool success, const GameRecord& saved) {
+        if (generation != saveGeneration) {
+            return;
+        }
+        saveStatus = success ? SaveStatus::SAVED : SaveStatus::FAILED;
+        screenRevision++;
+        markDirty();
+        if (success) {
+            LOG_INFO("💾 Результат сохранен в БД: " << saved.playerName);
+        } else {
+            LOG_WARN("⚠ Результат не сохранен: " << saved.playerName);
+        }
+    });
+    screenRevision++;
+}
+
+void Game::addSaveStatusText() {
+    const char* label = nullptr;
+    sf::Color color;
+    switch (saveStatus) {
+        case SaveStatus::SAVING:
+            label = "Saving result...";
+            color = sf::Color(200, 200, 200);
+            break;
+        case SaveStatus::SAVED:
+            label = "Result saved";
+            color = sf::Color(50, 205, 50);
+            break;
+        case SaveStatus::FAILED:
+            label = "Result not saved";
+            color = sf::Color(220, 80, 80);
+            break;
+        case SaveStatus::NONE:
+            return;
+    }
+    
+    screenText.addCentered(label, mainFont, 24, color,
+                           sf::Vector2f(window.getSize().x / 2, window.getSize().y - 190));
 }
 
 std::string Game::getCurrentDate() const {
@@ -1654,17 +2378,16 @@ std::string Game::getCurrentDate() const {
 }
 
 std::string Game::getDifficultyString() const {
-    switch (difficulty) {
-        case Difficulty::EASY: return "Easy";
-        case Difficulty::MEDIUM: return "Medium";
-        case Difficulty::HARD: return "Hard";
-        case Difficulty::EXPERT: return "Expert";
-        default: return "Unknown";
+    if (difficulty == Difficulty::CUSTOM) {
+        BoardSize size = getCustomBoardSize(customRows, customCols);
+        return std::string(getDifficultyName(difficulty)) + " " +
+               std::to_string(size.rows) + "x" + std::to_string(size.cols);
     }
+    return getDifficultyName(difficulty);
 }
 
 void Game::startNewGame() {
-    std::cout << "\n=== НАЧАЛО НОВОЙ ИГРЫ ===" << std::endl;
+    LOG_INFO("=== НАЧАЛО НОВОЙ ИГРЫ ===");
     currentState = GameState::ENTER_NAME;
     playerNameInput = "";
     isEnteringName = true;
@@ -1682,14 +2405,21 @@ void Game::resumeGame() {
     if (currentState == GameState::PAUSED) {
         currentState = GameState::PLAYING;
         isGameActive = true;
-        gameClock.restart();
     }
 }
 
 void Game::showLeaderboard() {
+    // При входе на экран перечитываем таблицу один раз
+    leaderboard.invalidate();
     currentState = GameState::LEADERBOARD;
 }
 
+void Game::showProfile() {
+    // Сводка перечитывается при первом кадре экрана
+    profileVersion = ~0ul;
+    currentState = GameState::PROFILE;
+}
+
 void Game::showSettings() {
     currentState = GameState::SETTINGS;
 }
@@ -1701,7 +2431,7 @@ void Game::exitGame() {
 void Game::surrenderGame() {
     if (!isGameActive) return;
     
-    std::cout << "Игрок сдался!" << std::endl;
+    LOG_INFO("Игрок сдался!");
     
     if (soundManager) {
         soundManager->playGameLose();
@@ -1710,21 +2440,22 @@ void Game::surrenderGame() {
     isGameActive = false;
     
     if (player) {
-        player->finishGame();
-        player->calculateScore(totalPairs);
+        player->calculateScore(totalPairs, getGameSeconds());
+        finishReplay(ReplayResult::SURRENDERED);
         
         GameRecord record;
         record.playerName = player->getName();
         record.score = player->getScore() / 2;
-        record.moves = moves;
-        record.pairs = matchedPairs;
+        record.moves = board.getMoves();
+        record.pairs = board.getMatchedPairs();
         record.time = elapsedTime.asSeconds();
         record.date = getCurrentDate();
         record.difficulty = getDifficultyString();
+        record.seed = dealSeed;
+        record.theme = getThemeName(currentTheme);
+        record.replay = replayName;
         
-        if (database) {
-            database->saveGame(record);
-        }
+        queueSave(record);
     }
     
     currentState = GameState::GAME_OVER_LOSE;
@@ -1732,8 +2463,141 @@ void Game::surrenderGame() {
 
 void Game::setDifficulty(Difficulty diff) {
     difficulty = diff;
+    screenRevision++;
+}
+
+void Game::setCustomBoardSize(int newRows, int newCols) {
+    // Храним стороны как заданы; чётность числа карт правит getCustomBoardSize
+    customRows = std::max(MinBoardSide, std::min(MaxBoardSide, newRows));
+    customCols = std::max(MinBoardSide, std::min(MaxBoardSide, newCols));
+    screenRevision++;
 }
 
 void Game::setTheme(CardTheme theme) {
     currentTheme = theme;
+    screenRevision++;
+    
+    // Атлас начинает грузиться в фоне сразу при выборе темы
+    prefetchTheme(theme);
+}
+
+void Game::prefetchTheme(CardTheme theme) {
+    std::string imageDir = getThemeImageDir(theme);
+    
+    if (themeAtlas && themeAtlas->isBuiltFor(imageDir)) {
+        return;
+    }
+    
+    if (resourceCache.find<ThemeAtlas>("atlas:" + imageDir)) {
+        return;
+    }
+    
+    themeLoader.start(imageDir);
+}
+
+std::shared_ptr<ThemeAtlas> Game::findThemeAtlas(const std::string& imageDir) {
+    if (themeAtlas && themeAtlas->isBuiltFor(imageDir)) {
+        return themeAtlas;
+    }
+    
+    if (auto atlas = resourceCache.find<ThemeAtlas>("atlas:" + imageDir)) {
+        return atlas;
+    }
+    
+    if (themeLoader.isReady(imageDir)) {
+        return themeLoader.getAtlas();
+    }
+    
+    return nullptr;
+}
+
+void Game::startPlaying() {
+    resetGame();
+    currentState = GameState::PLAYING;
+    isGameActive = true;
+    startReplay();
+    LOG_INFO("Игра начата! Всего пар: " << totalPairs);
+}
+
+void Game::startReplay() {
+    replayWriter.close();
+    replayName.clear();
+    if (replayDir.empty() || !player) {
+        return;
+    }
+    
+    std::error_code error;
+    std::filesystem::create_directories(replayDir, error);
+    
+    ReplayHeader header;
+    header.seed = dealSeed;
+    header.rows = rows;
+    header.cols = cols;
+    header.symbolCount = symbolCount;
+    header.difficulty = getDifficultyString();
+    header.playerName = player->getName();
+    
+    // Имя файла - зерно и время начала; при фиксированном зерне
+    // (MEMORY_GAME_SEED) партии не затирают повторы друг друга.
+    // Имя записывается в games.replay - по нему memory_replay находит партию
+    long long startMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    char base[48];
+    std::snprintf(base, sizeof(base), "%016llx-%lld", static_cast<unsigned long long>(dealSeed), startMs);
+    std::string path;
+    std::string name;
+    for (int attempt = 0; path.empty() || std::filesystem::exists(path, error); attempt++) {
+        name = std::string(base) + (attempt > 0 ? "-" + std::to_string(attempt) : "") + ".mgr";
+        path = (std::filesystem::path(replayDir) / name).string();
+    }
+    
+    if (replayWriter.open(path, header)) {
+        replayName = name;
+        LOG_INFO("🎬 Запись повтора: " << path);
+    } else {
+        LOG_WARN("⚠ Не удалось открыть файл повтора: " << path);
+    }
+}
+
+int Game::getGameSeconds() const {
+    // Целые секунды, как на экране; по ним считаются очки, их же пишет
+    // повтор - memory_replay пересчитывает очки из этого значения
+    return static_cast<int>(elapsedTime.asSeconds());
+}
+
+void Game::finishReplay(int outcome) {
+    ReplayResult result;
+    result.outcome = outcome;
+    result.moves = board.getMoves();
+    result.matchedPairs = board.getMatchedPairs();
+    result.elapsedSeconds = getGameSeconds();
+    result.score = player ? player->getScore() : 0;
+    replayWriter.finish(result);
+}
+
+std::shared_ptr<ThemeAtlas> Game::acquireThemeAtlas(const std::string& imageDir) {
+    // Недавно использованные темы остаются в кэше - повторный выбор без диска
+    const std::string key = "atlas:" + imageDir;
+    if (auto atlas = resourceCache.find<ThemeAtlas>(key)) {
+        LOG_INFO("♻ Атлас темы взят из кэша: " << imageDir);
+        return atlas;
+    }
+    
+    auto atlas = std::make_shared<ThemeAtlas>();
+    atlas->build(imageDir);
+    return resourceCache.insert(key, atlas, atlas->getByteSize());
+}
+
+std::string Game::getThemeImageDir(CardTheme theme) const {
+    std::string themeFolder;
+    switch (theme) {
+        case CardTheme::ANIMALS: themeFolder = "animals"; break;
+        case CardTheme::FRUITS: themeFolder = "fruits"; break;
+        case CardTheme::EMOJI: themeFolder = "emoji"; break;
+        case CardTheme::MEMES: themeFolder = "memes"; break;
+        case CardTheme::SYMBOLS: themeFolder = "symbols"; break;
+        default: themeFolder = "animals"; break;
+    }
+    
+    return "assets/images/" + themeFolder + "/";
 }
@@ -12,8 +12,21 @@
 #include "Card.h"
 #include "Player.h"
 #include "Database.h"
+#include "PersistenceWorker.h"
+#include "LeaderboardCache.h"
+#include "ResourceCache.h"
+#include "EventScheduler.h"
+#include "BoardEngine.h"
+#include "Difficulty.h"
+#include "Replay.h"
+#include "FrameTiming.h"
 #include "GUI/Button.h"
 #include "GUI/CardSprite.h"
+#include "GUI/BoardRenderer.h"
+#include "GUI/ThemeAtlas.h"
+#include "GUI/ThemeLoader.h"
+#include "GUI/TextCache.h"
+#include "GUI/ProfilerOverlay.h"
 #include "GUI/Menu.h"
 #include "Audio/SoundManager.h"
 #include "Audio/MusicPlayer.h"
@@ -23,30 +36,43 @@ enum class GameState {
     MAIN_MENU,
     ENTER_NAME,
     SETUP,
+    LOADING,       // фоновая загрузка темы перед стартом
     PLAYING,
     PAUSED,
     GAME_OVER_WIN,
     GAME_OVER_LOSE,
     LEADERBOARD,
+    PROFILE,       // сводка по текущему игроку
     SETTINGS,
     CONTACT_FORM,  // НОВОЕ СОСТОЯНИЕ
     EXIT
 };
 
-enum class Difficulty {
-    EASY,    // 3x4 = 12 cards (6 pairs)
-    MEDIUM,  // 4x4 = 16 cards (8 pairs)
-    HARD,    // 4x6 = 24 cards (12 pairs)
-    EXPERT   // 6x6 = 36 cards (18 pairs)
+// Как показывать кадры: свой ограничитель частоты, вертикальная
+// синхронизация или без ограничений (для замеров)
+enum class PresentMode {
+    CAPPED,
+    VSYNC,
+    UNCAPPED
+};
+
+// Запись результата партии в БД идёт в фоне; экран итогов показывает её ход
+enum class SaveStatus {
+    NONE,
+    SAVING,
+    SAVED,
+    FAILED
 };
 
 class Game {
+    // Внеэкранный замер отрисовки (tools/RenderBench.cpp)
+    friend class RenderBench;
+    
 private:
     // Window and rendering
     sf::RenderWindow window;
     sf::Font mainFont;
-    sf::Clock gameClock;
-    sf::Time elapsedTime;
+    sf::Time elapsedTime;  // игровое время - сумма тиков логики
     
     // Database
     Database db;
@@ -55,9 +81,21 @@ private:
     std::vector<std::unique_ptr<CardSprite>> cards;
     std::unique_ptr<Player> player;
     std::unique_ptr<Database> database;
+    // Объявлен после database: уничтожается первым и дописывает очередь
+    std::unique_ptr<PersistenceWorker> persistence;
+    LeaderboardCache leaderboard;
+    // Профиль читается из player_stats при входе и после новой записи
+    PlayerStats profileStats;
+    bool hasProfileStats;
+    unsigned long profileVersion;
     std::unique_ptr<SoundManager> soundManager;
     std::unique_ptr<MusicPlayer> musicPlayer;
     std::vector<Card> gameCards;
+    std::map<CardTheme, SymbolTable> themeSymbols;  // номера пар по темам
+    BoardRenderer boardRenderer;
+    ResourceCache resourceCache;
+    ThemeLoader themeLoader;
+    std::shared_ptr<ThemeAtlas> themeAtlas;
     
     // Input
     std::string playerNameInput;
@@ -66,11 +104,12 @@ private:
     sf::RectangleShape nameInputBox;
     
     // Backgrounds
-    sf::Texture menuBackgroundTexture;
-    sf::Texture gameBackgroundTexture;
-    sf::Sprite background;
+    // Фон - однотонный прямоугольник на всё окно, яркость входит в цвет
+    sf::RectangleShape background;
     sf::Color menuBackgroundColor;
     sf::Color gameBackgroundColor;
+    sf::Color menuBackgroundTint;
+    sf::Color gameBackgroundTint;
     
     // UI elements
     std::vector<Button> mainMenuButtons;
@@ -78,6 +117,7 @@ private:
     std::vector<Button> pauseButtons;
     std::vector<Button> setupButtons;
     std::vector<Button> leaderboardButtons;
+    std::vector<Button> profileButtons;
     std::vector<Button> settingsButtons;
     Button surrenderButton;
     
@@ -99,29 +139,99 @@ private:
     sf::Text difficultyText;
     sf::Text settingsTitle;
     
+    // Надписи текущего экрана и его фигуры - собираются при входе в
+    // состояние, смене размера окна или содержимого (screenRevision)
+    TextCache screenText;
+    GameState renderedState;
+    unsigned int screenRevision;
+    sf::RectangleShape screenOverlay;
+    sf::RectangleShape continueButton;
+    sf::RectangleShape loadingBarBackground;
+    sf::RectangleShape loadingBarFill;
+    
+    // Перерисовка по требованию: кадр рисуется, только если что-то изменилось
+    static constexpr float IdleFrameTime = 1.0f / 60.0f;
+    static constexpr float UnfocusedFrameTime = 0.1f;
+    bool needsRedraw;
+    
+    // Логика идёт тиками фиксированной длины, кадр рисуется между ними
+    // с долей alpha; длинный кадр (перетаскивание окна) обрезается
+    static constexpr float SimulationStep = 1.0f / 120.0f;
+    static constexpr float MaxFrameTime = 0.25f;
+    float simulationAccumulator;
+    float renderAlpha;
+    PresentMode presentMode;
+    int frameRateLimit;
+    sf::Clock pacingClock;
+    sf::Time nextFrameDeadline;
+    
+    // Замер фаз кадра; MEMORY_GAME_FRAME_STATS=1 печатает сводку раз в 5 секунд,
+    // F3 показывает оверлей, F4 сохраняет историю в CSV, F5 включает и
+    // выключает трассировку (Trace.h)
+    FrameTiming frameTiming;
+    FrameSample currentFrame;
+    ProfilerOverlay profilerOverlay;
+    bool logFrameStats;
+    sf::Clock frameStatsClock;
+    
+    // Размеры карточек для раскладки поля
+    static constexpr float CardSize = 80.0f;
+    static constexpr float CardSpacing = 10.0f;
+    
+    // Поле лежит в своём виде (sf::View) с прокруткой и масштабом.
+    // Карта i стоит в клетке сетки, поэтому клик и видимость считаются
+    // арифметикой, без обхода всех карт
+    static constexpr float BoardTopOffset = 50.0f;   // сдвиг поля вниз под заголовок
+    static constexpr float BoardPanMargin = 200.0f;  // запас прокрутки за край поля, пиксели
+    static constexpr float MinBoardZoom = 0.5f;
+    static constexpr float MaxBoardZoom = 8.0f;
+    sf::View boardView;
+    float boardZoom;
+    sf::Vector2f boardCenter;
+    sf::IntRect visibleCells;  // видимые столбцы (left, width) и строки (top, height)
+    bool isPanning;
+    sf::Vector2i panAnchor;
+    int customRows, customCols;
+    bool hasFocus;
+    int lastTimerSeconds;
+    unsigned long lastCardsRevision;
+    
+    // Куда рисуют render*-функции: окно или внеэкранная текстура (render_bench)
+    sf::RenderTarget* renderTarget;
+    unsigned int drawCalls;
+    
     // Game state
     GameState currentState;
     GameState previousState;  // Для возврата из формы обратной связи
     Difficulty difficulty;
     CardTheme currentTheme;
     int rows, cols, totalPairs;
-    int matchedPairs;
-    int moves;
     bool isGameActive;
-    bool firstCardSelected;
-    int selectedCard1, selectedCard2;
     
     // Animation
     float cardFlipTime;
-    float cardFlipProgress;
+    float mismatchDelay;
     bool isFlipping;
+    std::vector<int> animatingCards;  // карты в середине переворота
+    
+    // Отложенные действия (переворот, скрытие несовпавших карт)
+    EventScheduler scheduler;
+    
+    // Правила и состояние поля; спрайты только отображают его
+    BoardEngine board;
     
-    // Card pointers for comparison
-    CardSprite* firstCard;
-    CardSprite* secondCard;
+    // Зерно раскладки и запись партии: по ним memory_replay повторяет игру
+    std::uint64_t dealSeed;
+    std::uint64_t fixedDealSeed;  // MEMORY_GAME_SEED; 0 - случайное зерно
+    int symbolCount;              // сколько символов темы делят пары
+    ReplayWriter replayWriter;
+    std::string replayDir;
+    std::string replayName;       // файл повтора текущей партии; пишется в games.replay
     bool isChecking;
     
     bool hasWon;
+    SaveStatus saveStatus;
+    unsigned int saveGeneration;  // отбрасывает ответы о сохранении прошлых партий
     
     // Resource paths
     std::map<CardTheme, std::string> themeImagePaths;
@@ -131,12 +241,26 @@ private:
     
     // Private methods
     void updateBackgrounds();
+    void layoutUI();
+    void layoutColumn(std::vector<Button>& buttons, float width, float startY, float spacing);
+    sf::Vector2f getCardPosition(int index) const;
+    void resetBoardView();
+    void updateBoardView();
+    void zoomBoard(float factor, const sf::Vector2i& pixel);
+    void panBoard(const sf::Vector2f& pixels);
+    int findCardAt(const sf::Vector2i& pixel) const;
+    bool handleBoardEvent(const sf::Event& event);
+    void setCustomBoardSize(int rows, int cols);
     void loadResources();
     void setupMainMenu();
     void setupGameUI();
     void setupPauseMenu();
     void setupSetupMenu();
     void setupLeaderboardUI();
+    void setupProfileUI();
+    void cycleLeaderboardDifficulty();
+    void cycleLeaderboardTheme();
+    void updateLeaderboardButtons();
     void setupSettingsMenu();
     void setupContactForm();
     void initializeCards();
@@ -145,7 +269,13 @@ private:
     void updateStats();
     void handleCardClick(int cardIndex);
     void processCardMatch();
+    void syncCardSprite(int index);
     void saveGameResult();
+    void queueSave(const GameRecord& record);
+    void addSaveStatusText();
+    void startReplay();
+    void finishReplay(int outcome);
+    int getGameSeconds() const;
     void renderNameInput();
     void renderContactForm();
     std::string getDifficultyString() const;
@@ -158,8 +288,34 @@ private:
     void renderGameOverWin();
     void renderGameOverLose();
     void renderLeaderboard();
+    void renderProfile();
     void renderSettings();
     void getImagePathsForTheme(CardTheme theme, std::vector<std::string>& imagePaths);
+    std::string getThemeImageDir(CardTheme theme) const;
+    std::shared_ptr<ThemeAtlas> acquireThemeAtlas(const std::string& imageDir);
+    std::shared_ptr<ThemeAtlas> findThemeAtlas(const std::string& imageDir);
+    void prefetchTheme(CardTheme theme);
+    void startPlaying();
+    void renderLoading();
+    bool rebuildScreenText();
+    bool updateContinueButton(const sf::Color& idle, const sf::Color& hover);
+    void updateButtons(std::vector<Button>& buttons, const sf::Vector2f& mousePos);
+    unsigned long getCardsRevision() const;
+    void markDirty() { needsRedraw = true; }
+    void renderFrame();
+    void draw(const sf::Drawable& drawable);
+    void draw(Button& button);
+    void draw(const TextCache& texts);
+    void processEvent(const sf::Event& event, const sf::Vector2f& mousePos);
+    void waitForActivity();
+    void paceFrame();
+    void applyPresentMode();
+    void logFrameTiming();
+    void dumpFrameTiming();
+    void toggleTrace();
+    float getFrameBudgetMs() const;
+    static const char* getPresentModeName(PresentMode mode);
+    float getIdleTimeout() const;
 
 public:
     Game();
@@ -176,6 +332,7 @@ public:
     void pauseGame();
     void resumeGame();
     void showLeaderboard();
+    void showProfile();
     void showSettings();
     void exitGame();
     void surrenderGame();
@@ -0,0 +1,671 @@
+#include "GameArchive.h"
+#include "Log.h"
+#include "Trace.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Столбцы в порядке SELECT * FROM games
+    enum Column {
+        ID,
+        PLAYER_NAME,
+        SCORE,
+        MOVES,
+        PAIRS,
+        TIME,
+        DATE,
+        DIFFICULTY,
+        SEED,
+        THEME,
+        REPLAY,
+        ColumnCount,
+        UNKNOWN = ColumnCount
+    };
+
+    const char* const ColumnNames[] = {
+        "id", "player_name", "score", "moves", "pairs", "time", "date", "difficulty", "seed", "theme", "replay"
+    };
+
+    // Буфер потока файла; строки собираются в std::string без перевыделений
+    const std::size_t StreamBufferSize = 1 << 20;
+    
+    // Разобранные записи идут к вставке пачками; в пути не больше
+    // PipeChunks пачек - память постоянна при любом размере файла
+    const std::size_t PipeChunkRows = 4096;
+    const std::size_t PipeChunks = 4;
+
+    Column findColumn(const std::string& name) {
+        for (int i = 0; i < ColumnCount; i++) {
+            if (name == ColumnNames[i]) {
+                return static_cast<Column>(i);
+            }
+        }
+        return UNKNOWN;
+    }
+
+    template <typename T>
+    bool parseInteger(const std::string& value, T& result) {
+        const char* end = value.data() + value.size();
+        auto parsed = std::from_chars(value.data(), end, result);
+        return parsed.ec == std::errc() && parsed.ptr == end;
+    }
+
+    bool setField(GameRecord& record, Column column, const std::string& value) {
+        switch (column) {
+            case PLAYER_NAME: record.playerName = value; return !value.empty();
+            case SCORE: return parseInteger(value, record.score);
+            case MOVES: return parseInteger(value, record.moves);
+            case PAIRS: return parseInteger(value, record.pairs);
+            case TIME: {
+                char* end = nullptr;
+                record.time = std::strtod(value.c_str(), &end);
+                return !value.empty() && *end == '\0';
+            }
+            case DATE: record.date = value; return true;
+            case DIFFICULTY: record.difficulty = value; return true;
+            case SEED: return parseInteger(value, record.seed);
+            case THEME: record.theme = value; return true;
+            case REPLAY: record.replay = value; return true;
+            case ID:
+            case UNKNOWN:
+                return true;
+        }
+        return true;
+    }
+
+    void clearRecord(GameRecord& record) {
+        record.id = 0;
+        record.playerName.clear();
+        record.score = 0;
+        record.moves = 0;
+        record.pairs = 0;
+        record.time = 0.0;
+        record.date.clear();
+        record.difficulty.clear();
+        record.seed = 0;
+        record.theme.clear();
+        record.replay.clear();
+    }
+
+    void appendNumber(std::string& out, double value) {
+        char buffer[32];
+        int size = std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+        out.append(buffer, size);
+    }
+
+    // ===== CSV (RFC 4180) =====
+
+    void appendCsvField(std::string& out, const std::string& value) {
+        if (value.find_first_of(",\"\r\n") == std::string::npos) {
+            out += value;
+            return;
+        }
+        out += '"';
+        for (char c : value) {
+            if (c == '"') {
+                out += '"';
+            }
+            out += c;
+        }
+        out += '"';
+    }
+
+    void appendCsv(std::string& out, const GameRecord& record) {
+        out += std::to_string(record.id);
+        out += ',';
+        appendCsvField(out, record.playerName);
+        out += ',';
+        out += std::to_string(record.score);
+        out += ',';
+        out += std::to_string(record.moves);
+        out += ',';
+        out += std::to_string(record.pairs);
+        out += ',';
+        appendNumber(out, record.time);
+        out += ',';
+        appendCsvField(out, record.date);
+        out += ',';
+        appendCsvField(out, record.difficulty);
+        out += ',';
+        out += std::to_string(record.seed);
+        out += ',';
+        appendCsvField(out, record.theme);
+        out += ',';
+        appendCsvField(out, record.replay);
+        out += '\n';
+    }
+
+    // false - строка оборвалась внутри кавычек (перевод строки в поле)
+    bool splitCsv(const std::string& line, std::vector<std::string>& fields, std::size_t& count) {
+        count = 0;
+        std::size_t pos = 0;
+        while (true) {
+            if (count == fields.size()) {
+                fields.emplace_back();
+            }
+            std::string& field = fields[count++];
+            field.clear();
+
+            if (pos < line.size() && line[pos] == '"') {
+                pos++;
+                while (true) {
+                    if (pos >= line.size()) {
+                        return false;
+                    }
+                    if (line[pos] == '"') {
+                        if (pos + 1 < line.size() && line[pos + 1] == '"') {
+                            field += '"';
+                            pos += 2;
+                            continue;
+                        }
+                        pos++;
+                        break;
+                    }
+                    field += line[pos++];
+                }
+            }
+
+            std::size_t end = line.find(',', pos);
+            field.append(line, pos, end == std::string::npos ? std::string::npos : end - pos);
+            if (end == std::string::npos) {
+                return true;
+            }
+            pos = end + 1;
+        }
+    }
+
+    // ===== JSONL =====
+
+    void appendJsonString(std::string& out, const std::string& value) {
+        out += '"';
+        for (unsigned char c : value) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (c < 0x20) {
+                        char buffer[8];
+                        std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                        out += buffer;
+                    } else {
+                        out += static_cast<char>(c);
+                    }
+            }
+        }
+        out += '"';
+    }
+
+    void appendJson(std::string& out, const GameRecord& record) {
+        out += "{\"id\":";
+        out += std::to_string(record.id);
+        out += ",\"player_name\":";
+        appendJsonString(out, record.playerName);
+        out += ",\"score\":";
+        out += std::to_string(record.score);
+        out += ",\"moves\":";
+        out += std::to_string(record.moves);
+        out += ",\"pairs\":";
+        out += std::to_string(record.pairs);
+        out += ",\"time\":";
+        appendNumber(out, record.time);
+        out += ",\"date\":";
+        appendJsonString(out, record.date);
+        out += ",\"difficulty\":";
+        appendJsonString(out, record.difficulty);
+        out += ",\"seed\":";
+        out += std::to_string(record.seed);
+        out += ",\"theme\":";
+        appendJsonString(out, record.theme);
+        out += ",\"replay\":";
+        appendJsonString(out, record.replay);
+        out += "}\n";
+    }
+
+    void appendUtf8(std::string& out, unsigned long code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    // Плоский объект: ключи - строки, значения - строки, числа или null
+    class JsonLineReader {
+    private:
+        const std::string& line;
+        std::size_t pos;
+
+        void skipSpace() {
+            while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t' || line[pos] == '\r')) {
+                pos++;
+            }
+        }
+
+        bool readHex(unsigned long& code) {
+            if (pos + 4 > line.size()) {
+                return false;
+            }
+            code = std::strtoul(line.substr(pos, 4).c_str(), nullptr, 16);
+            pos += 4;
+            return true;
+        }
+
+        bool readString(std::string& value) {
+            value.clear();
+            if (pos >= line.size() || line[pos] != '"') {
+                return false;
+            }
+            pos++;
+            while (pos < line.size()) {
+                char c = line[pos++];
+                if (c == '"') {
+                    return true;
+                }
+                if (c != '\\') {
+                    value += c;
+                    continue;
+                }
+                if (pos >= line.size()) {
+                    return false;
+                }
+                switch (line[pos++]) {
+                    case '"': value += '"'; break;
+                    case '\\': value += '\\'; break;
+                    case '/': value += '/'; break;
+                    case 'b': value += '\b'; break;
+                    case 'f': value += '\f'; break;
+                    case 'n': value += '\n'; break;
+                    case 'r': value += '\r'; break;
+                    case 't': value += '\t'; break;
+                    case 'u': {
+                        unsigned long code;
+                        if (!readHex(code)) {
+                            return false;
+                        }
+                        // Суррогатная пара - символ вне основной плоскости
+                        if (code >= 0xD800 && code < 0xDC00 && line.compare(pos, 2, "\\u") == 0) {
+                            pos += 2;
+                            unsigned long low;
+                            if (!readHex(low)) {
+                                return false;
+                            }
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        }
+                        appendUtf8(value, code);
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+            return false;
+        }
+
+        // Число или литерал - до запятой или закрывающей скобки
+        void readBare(std::string& value) {
+            std::size_t end = line.find_first_of(",} \t\r", pos);
+            if (end == std::string::npos) {
+                end = line.size();
+            }
+            value.assign(line, pos, end - pos);
+            pos = end;
+        }
+
+    public:
+        explicit JsonLineReader(const std::string& line) : line(line), pos(0) {}
+
+        bool read(GameRecord& record, std::string& key, std::string& value) {
+            skipSpace();
+            if (pos >= line.size() || line[pos++] != '{') {
+                return false;
+            }
+            skipSpace();
+            if (pos < line.size() && line[pos] == '}') {
+                return false;
+            }
+
+            while (true) {
+                skipSpace();
+                if (!readString(key)) {
+                    return false;
+                }
+                skipSpace();
+                if (pos >= line.size() || line[pos++] != ':') {
+                    return false;
+                }
+                skipSpace();
+
+                bool isString = pos < line.size() && line[pos] == '"';
+                if (isString) {
+                    if (!readString(value)) {
+                        return false;
+                    }
+                } else {
+                    readBare(value);
+                    if (value.empty()) {
+                        return false;
+                    }
+                }
+                if ((isString || value != "null") && !setField(record, findColumn(key), value)) {
+                    return false;
+                }
+
+                skipSpace();
+                if (pos >= line.size()) {
+                    return false;
+                }
+                char c = line[pos++];
+                if (c == '}') {
+                    return true;
+                }
+                if (c != ',') {
+                    return false;
+                }
+            }
+        }
+    };
+}
+
+namespace {
+    // Разбор файла в своём потоке, пока SQLite вставляет предыдущие пачки.
+    // Пачки возвращаются разборщику пустыми - строки в записях сохраняют
+    // выделенную память
+    class RecordPipe {
+    private:
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<std::vector<GameRecord>> full;
+        std::vector<std::vector<GameRecord>> empty;
+        std::vector<GameRecord> reading;
+        std::size_t readPos;
+        bool finished;  // разборщик дошёл до конца файла
+        bool closed;    // загрузка прервана, разбор не нужен
+
+    public:
+        RecordPipe() : readPos(0), finished(false), closed(false) {
+            for (std::size_t i = 0; i < PipeChunks; i++) {
+                empty.emplace_back(PipeChunkRows);
+            }
+        }
+
+        // Поток разбора: parse заполняет запись, false - конец файла
+        template <typename Parse>
+        void produce(Parse parse) {
+            while (true) {
+                std::vector<GameRecord> chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [this]() { return closed || !empty.empty(); });
+                    if (closed) {
+                        return;
+                    }
+                    chunk = std::move(empty.back());
+                    empty.pop_back();
+                }
+
+                std::size_t count = 0;
+                while (count < PipeChunkRows && parse(chunk[count])) {
+                    count++;
+                }
+                bool last = count < PipeChunkRows;
+                chunk.resize(count);
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    full.push_back(std::move(chunk));
+                    finished = last;
+                }
+                changed.notify_all();
+                if (last) {
+                    return;
+                }
+            }
+        }
+
+        // Поток вставки: следующая запись или false в конце
+        bool next(GameRecord& record) {
+            while (readPos >= reading.size()) {
+                std::unique_lock<std::mutex> lock(mutex);
+                // Прочитанная пачка возвращается разборщику
+                if (reading.capacity() > 0) {
+                    reading.resize(PipeChunkRows);
+                    empty.push_back(std::move(reading));
+                    reading = std::vector<GameRecord>();
+                    changed.notify_all();
+                }
+                changed.wait(lock, [this]() { return !full.empty() || finished; });
+                if (full.empty()) {
+                    return false;
+                }
+                reading = std::move(full.front());
+                full.pop_front();
+                readPos = 0;
+            }
+
+            std::swap(record, reading[readPos++]);
+            return true;
+        }
+
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closed = true;
+            }
+            changed.notify_all();
+        }
+    };
+}
+
+bool GameArchive::getFormat(const std::string& path, Format& format) {
+    auto endsWith = [&path](const std::string& suffix) {
+        return path.size() >= suffix.size() &&
+               path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+
+    if (endsWith(".csv")) {
+        format = Format::CSV;
+    } else if (endsWith(".jsonl") || endsWith(".ndjson")) {
+        format = Format::JSONL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool GameArchive::exportGames(Database& database, const std::string& path, Format format,
+                              Stats& stats, std::string& error) {
+    TRACE_SCOPE("GameArchive::exportGames");
+    stats = Stats();
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<char> buffer(StreamBufferSize);
+    std::ofstream out;
+    out.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "не удалось открыть " + path;
+        return false;
+    }
+
+    std::string line;
+    if (format == Format::CSV) {
+        for (int i = 0; i < ColumnCount; i++) {
+            line += ColumnNames[i];
+            line += i + 1 < ColumnCount ? ',' : '\n';
+        }
+        out.write(line.data(), line.size());
+    }
+
+    bool success = database.forEachGame([&](const GameRecord& record) {
+        line.clear();
+        if (format == Format::CSV) {
+            appendCsv(line, record);
+        } else {
+            appendJson(line, record);
+        }
+        out.write(line.data(), line.size());
+        stats.rows++;
+        return static_cast<bool>(out);
+    });
+
+    out.flush();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!out) {
+        error = "ошибка записи в " + path;
+        return false;
+    }
+    if (!success) {
+        error = "не удалось прочитать таблицу games";
+        return false;
+    }
+    return true;
+}
+
+bool GameArchive::importGames(Database& database, const std::string& path, Format format,
+                              Stats& stats, std::string& error) {
+    TRACE_SCOPE("GameArchive::importGames");
+    stats = Stats();
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<char> buffer(StreamBufferSize);
+    std::ifstream in;
+    in.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    in.open(path, std::ios::binary);
+    if (!in) {
+        error = "не удалось открыть " + path;
+        return false;
+    }
+
+    std::string line;
+    std::string key;
+    std::string value;
+    std::vector<std::string> fields;
+    std::vector<Column> header;
+    std::size_t fieldCount = 0;
+    std::size_t lineNumber = 0;
+
+    // Строка CSV целиком, с переводами строк внутри кавычек
+    auto readCsvRow = [&]() {
+        if (!std::getline(in, line)) {
+            return false;
+        }
+        lineNumber++;
+        while (!splitCsv(line, fields, fieldCount)) {
+            std::string more;
+            if (!std::getline(in, more)) {
+                break;
+            }
+            lineNumber++;
+            line += '\n';
+            line += more;
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+            splitCsv(line, fields, fieldCount);
+        }
+        return true;
+    };
+
+    if (format == Format::CSV) {
+        if (!readCsvRow()) {
+            error = "файл пуст";
+            return false;
+        }
+        for (std::size_t i = 0; i < fieldCount; i++) {
+            header.push_back(findColumn(fields[i]));
+        }
+        if (std::find(header.begin(), header.end(), PLAYER_NAME) == header.end() ||
+            std::find(header.begin(), header.end(), SCORE) == header.end()) {
+            error = "в заголовке CSV нет столбцов player_name и score";
+            return false;
+        }
+    }
+
+    auto parse = [&](GameRecord& record) {
+        while (true) {
+            bool parsed = false;
+            clearRecord(record);
+
+            if (format == Format::CSV) {
+                if (!readCsvRow()) {
+                    return false;
+                }
+                if (line.empty()) {
+                    continue;
+                }
+                parsed = fieldCount == header.size();
+                for (std::size_t i = 0; parsed && i < fieldCount; i++) {
+                    parsed = setField(record, header[i], fields[i]);
+                }
+            } else {
+                if (!std::getline(in, line)) {
+                    return false;
+                }
+                lineNumber++;
+                if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                    continue;
+                }
+                JsonLineReader reader(line);
+                parsed = reader.read(record, key, value);
+            }
+
+            if (parsed && !record.playerName.empty()) {
+                return true;
+            }
+            if (stats.skipped++ < 10) {
+                LOG_WARN("⚠ " << path << ":" << lineNumber << ": строка не разобрана, пропущена");
+            }
+        }
+    };
+
+    // Database забирает запись за записью; на многоядерной машине разбор
+    // идёт в отдельном потоке параллельно со вставкой
+    bool success;
+    if (std::thread::hardware_concurrency() > 1) {
+        RecordPipe pipe;
+        std::thread parser([&]() {
+            TRACE_THREAD("archive parser");
+            pipe.produce(parse);
+        });
+        success = database.importGames([&pipe](GameRecord& record) { return pipe.next(record); },
+                                       stats.rows);
+        pipe.close();
+        parser.join();
+    } else {
+        success = database.importGames(parse, stats.rows);
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (in.bad()) {
+        error = "ошибка чтения " + path;
+        return false;
+    }
+    if (!success) {
+        error = "ошибка записи в БД, загружено " + std::to_string(stats.rows) + " строк";
+        return false;
+    }
+    return true;
+}
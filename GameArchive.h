@@ -0,0 +1,37 @@
+#ifndef GAMEARCHIVE_H
+#define GAMEARCHIVE_H
+
+#include <cstddef>
+#include <string>
+#include "Database.h"
+
+// Выгрузка и загрузка таблицы games в CSV или JSONL.
+// Строки идут потоком в обе стороны - память не зависит от числа партий.
+// CSV: первая строка - имена столбцов как в games (порядок любой, лишние
+// столбцы пропускаются); JSONL: объект на строку с теми же ключами.
+// id при загрузке не переносится - партии получают новые номера.
+class GameArchive {
+public:
+    enum class Format {
+        CSV,
+        JSONL
+    };
+
+    struct Stats {
+        std::size_t rows = 0;     // выгружено или загружено
+        std::size_t skipped = 0;  // строки, которые не удалось разобрать
+        double seconds = 0.0;
+
+        double getRowsPerSecond() const { return seconds > 0.0 ? rows / seconds : 0.0; }
+    };
+
+    // По расширению: .csv, .jsonl или .ndjson
+    static bool getFormat(const std::string& path, Format& format);
+
+    static bool exportGames(Database& database, const std::string& path, Format format,
+                            Stats& stats, std::string& error);
+    static bool importGames(Database& database, const std::string& path, Format format,
+                            Stats& stats, std::string& error);
+};
+
+#endif
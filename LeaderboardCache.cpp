@@ -0,0 +1,48 @@
+#include "LeaderboardCache.h"
+
+LeaderboardCache::LeaderboardCache(int limit)
+    : limit(limit), difficulty(Database::AnyBoard), theme(Database::AnyBoard),
+      version(0), valid(false), queryCount(0) {
+}
+
+void LeaderboardCache::setBoard(const std::string& newDifficulty, const std::string& newTheme) {
+    if (newDifficulty != difficulty || newTheme != theme) {
+        difficulty = newDifficulty;
+        theme = newTheme;
+        valid = false;
+    }
+}
+
+bool LeaderboardCache::isStale(const Database* database) const {
+    if (!valid) {
+        return true;
+    }
+
+    // Без базы показываем пустую таблицу, пока её не подключат
+    return database ? database->getVersion() != version : !records.empty();
+}
+
+const std::vector<GameRecord>& LeaderboardCache::getTopScores(Database* database) {
+    if (!isStale(database)) {
+        return records;
+    }
+
+    if (database) {
+        // Хранимые таблицы держат LeaderboardSize строк; длинный общий
+        // список (render_bench --rows) читается по индексу очков
+        if (limit > Database::LeaderboardSize &&
+            difficulty == Database::AnyBoard && theme == Database::AnyBoard) {
+            records = database->getTopScores(limit);
+        } else {
+            records = database->getLeaderboard(difficulty, theme);
+        }
+        version = database->getVersion();
+        queryCount++;
+    } else {
+        records.clear();
+        version = 0;
+    }
+
+    valid = true;
+    return records;
+}
@@ -0,0 +1,36 @@
+#ifndef LEADERBOARDCACHE_H
+#define LEADERBOARDCACHE_H
+
+#include <string>
+#include <vector>
+#include "Database.h"
+
+// Кэш таблицы лидеров перед Database.
+// Запрос к SQLite выполняется только если кэш сброшен (вход на экран,
+// смена таблицы) или версия базы изменилась после сохранения нового результата.
+class LeaderboardCache {
+private:
+    std::vector<GameRecord> records;
+    int limit;
+    std::string difficulty;  // показываемая таблица; Database::AnyBoard - все
+    std::string theme;
+    unsigned long version;  // версия базы, из которой взяты записи
+    bool valid;
+    unsigned long queryCount;
+
+public:
+    explicit LeaderboardCache(int limit = Database::LeaderboardSize);
+
+    void setBoard(const std::string& difficulty, const std::string& theme);
+    const std::string& getDifficulty() const { return difficulty; }
+    const std::string& getTheme() const { return theme; }
+
+    bool isStale(const Database* database) const;
+    const std::vector<GameRecord>& getTopScores(Database* database);
+    void invalidate() { valid = false; }
+
+    int getLimit() const { return limit; }
+    unsigned long getQueryCount() const { return queryCount; }
+};
+
+#endif
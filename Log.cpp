@@ -0,0 +1,271 @@
+#include "Log.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+    struct LogEntry {
+        LogLevel level = LogLevel::INFO;
+        std::int64_t timeUs = 0;
+        std::string message;
+    };
+
+    // Ограниченная очередь многих писателей и одного читателя (Д. Вьюков):
+    // у каждой ячейки свой номер; писатель занимает позицию CAS-ом,
+    // читатель забирает ячейку, когда её номер догнал позицию чтения
+    class LogQueue {
+    private:
+        struct Slot {
+            std::atomic<std::size_t> sequence;
+            LogEntry entry;
+        };
+
+        static constexpr std::size_t Capacity = 4096;  // степень двойки
+        static constexpr std::size_t Mask = Capacity - 1;
+
+        std::unique_ptr<Slot[]> slots;
+        alignas(64) std::atomic<std::size_t> enqueuePos;
+        alignas(64) std::atomic<std::size_t> dequeuePos;
+
+    public:
+        LogQueue() : slots(new Slot[Capacity]), enqueuePos(0), dequeuePos(0) {
+            for (std::size_t i = 0; i < Capacity; i++) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        bool push(LogEntry& entry) {
+            std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            Slot* slot;
+            for (;;) {
+                slot = &slots[pos & Mask];
+                std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;  // очередь полна
+                } else {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->entry = std::move(entry);
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(LogEntry& entry) {
+            std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+            Slot& slot = slots[pos & Mask];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1) < 0) {
+                return false;  // пусто
+            }
+
+            dequeuePos.store(pos + 1, std::memory_order_relaxed);
+            entry = std::move(slot.entry);
+            slot.sequence.store(pos + Capacity, std::memory_order_release);
+            return true;
+        }
+    };
+
+    class LogWriter {
+    private:
+        LogQueue queue;
+        std::thread worker;
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        // Печать из потока журнала и синхронная печать после stop() не
+        // перемешиваются в одной строке
+        std::mutex printMutex;
+        std::atomic<bool> sleeping;
+        std::atomic<bool> stopping;
+        std::atomic<bool> running;
+        std::atomic<int> writers;  // write() между проверкой stopping и push
+        std::atomic<unsigned long> pushed;
+        std::atomic<unsigned long> printed;
+        std::atomic<unsigned long> dropped;
+        std::once_flag startFlag;
+        const std::chrono::steady_clock::time_point epoch;
+
+        static void print(const LogEntry& entry) {
+            static const char Letters[] = {'D', 'I', 'W', 'E'};
+            char prefix[32];
+            std::snprintf(prefix, sizeof(prefix), "[%5lld.%03lld] %c ",
+                          static_cast<long long>(entry.timeUs / 1000000),
+                          static_cast<long long>(entry.timeUs / 1000 % 1000),
+                          Letters[static_cast<int>(entry.level)]);
+
+            std::ostream& out = entry.level >= LogLevel::ERROR ? std::cerr : std::cout;
+            out << prefix << entry.message << '\n';
+        }
+
+        void run() {
+            LogEntry entry;
+            while (true) {
+                bool any = false;
+                {
+                    std::lock_guard<std::mutex> lock(printMutex);
+                    while (queue.pop(entry)) {
+                        print(entry);
+                        printed++;
+                        any = true;
+                    }
+
+                    unsigned long lost = dropped.exchange(0);
+                    if (lost > 0) {
+                        std::cout << "⚠ Журнал: очередь переполнена, пропущено " << lost << " сообщений\n";
+                    }
+                    if (any) {
+                        std::cout.flush();
+                    }
+                }
+
+                if (any) {
+                    continue;
+                }
+                if (stopping) {
+                    break;
+                }
+
+                // Писатель будит поток без замка; пропущенное пробуждение
+                // ограничено таймаутом ожидания
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                sleeping = true;
+                wake.wait_for(lock, std::chrono::milliseconds(20));
+                sleeping = false;
+            }
+            std::cout.flush();
+        }
+
+    public:
+        LogWriter()
+            : sleeping(false), stopping(false), running(false), writers(0),
+              pushed(0), printed(0), dropped(0), epoch(std::chrono::steady_clock::now()) {
+        }
+
+        ~LogWriter() {
+            stop();
+        }
+
+        void write(LogLevel level, std::string message) {
+            LogEntry entry;
+            entry.level = level;
+            entry.timeUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - epoch).count();
+            entry.message = std::move(message);
+
+            // Счётчик поднят до проверки stopping: stop() дождётся этого
+            // push, прежде чем допечатать очередь
+            writers++;
+            if (stopping) {
+                writers--;
+                std::lock_guard<std::mutex> lock(printMutex);
+                print(entry);
+                return;
+            }
+
+            std::call_once(startFlag, [this]() {
+                running = true;
+                worker = std::thread(&LogWriter::run, this);
+            });
+
+            bool queued = queue.push(entry);
+            writers--;
+            if (!queued) {
+                dropped++;
+                return;
+            }
+            pushed++;
+
+            if (sleeping.load(std::memory_order_acquire)) {
+                wake.notify_one();
+            }
+        }
+
+        void flush() {
+            unsigned long target = pushed.load();
+            while (running && !stopping && printed.load() < target) {
+                wake.notify_one();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        void stop() {
+            if (stopping.exchange(true)) {
+                return;
+            }
+            // Писатели, увидевшие stopping == false, ещё кладут сообщения
+            while (writers.load() > 0) {
+                std::this_thread::yield();
+            }
+            if (worker.joinable()) {
+                wake.notify_one();
+                worker.join();
+            }
+            running = false;
+
+            // Успевшее попасть в очередь после последнего прохода потока
+            std::lock_guard<std::mutex> lock(printMutex);
+            LogEntry entry;
+            while (queue.pop(entry)) {
+                print(entry);
+            }
+            unsigned long lost = dropped.exchange(0);
+            if (lost > 0) {
+                std::cout << "⚠ Журнал: очередь переполнена, пропущено " << lost << " сообщений\n";
+            }
+            std::cout.flush();
+        }
+    };
+
+    LogWriter& getWriter() {
+        static LogWriter writer;
+        return writer;
+    }
+}
+
+std::atomic<int> Log::threshold(MEMORY_GAME_LOG_LEVEL);
+
+void Log::setLevel(LogLevel level) {
+    threshold = static_cast<int>(level);
+}
+
+LogLevel Log::getLevel() {
+    return static_cast<LogLevel>(threshold.load());
+}
+
+bool Log::parseLevel(const std::string& name, LogLevel& level) {
+    if (name == "debug") {
+        level = LogLevel::DEBUG;
+    } else if (name == "info") {
+        level = LogLevel::INFO;
+    } else if (name == "warn") {
+        level = LogLevel::WARN;
+    } else if (name == "error") {
+        level = LogLevel::ERROR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void Log::write(LogLevel level, std::string message) {
+    getWriter().write(level, std::move(message));
+}
+
+void Log::flush() {
+    getWriter().flush();
+}
+
+void Log::shutdown() {
+    getWriter().stop();
+}
@@ -0,0 +1,86 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+// Уровни журнала по возрастанию важности
+enum class LogLevel {
+    DEBUG = 0,
+    INFO = 1,
+    WARN = 2,
+    ERROR = 3
+};
+
+// Уровень, ниже которого вызовы LOG_* не попадают в сборку
+// (CMake: MEMORY_GAME_LOG_LEVEL, 0 - debug ... 3 - error)
+#ifndef MEMORY_GAME_LOG_LEVEL
+#define MEMORY_GAME_LOG_LEVEL 1
+#endif
+
+// Асинхронный журнал.
+// Сообщение собирается в вызывающем потоке и кладётся в кольцевую очередь
+// без блокировок; печатает фоновый поток, поэтому медленный терминал или
+// лог-драйвер Docker не задерживают кадр. При переполнении очереди
+// сообщения отбрасываются и считаются, вызывающий поток никогда не ждёт.
+class Log {
+private:
+    static std::atomic<int> threshold;
+
+public:
+    static bool isEnabled(LogLevel level) {
+        return static_cast<int>(level) >= threshold.load(std::memory_order_relaxed);
+    }
+    static void setLevel(LogLevel level);
+    static LogLevel getLevel();
+    // debug, info, warn, error
+    static bool parseLevel(const std::string& name, LogLevel& level);
+
+    static void write(LogLevel level, std::string message);
+    // Ждёт, пока всё записанное до вызова будет напечатано
+    static void flush();
+    // Допечатывает очередь и останавливает поток; дальше печать синхронная
+    static void shutdown();
+};
+
+#define LOG_AT(level, expr)                              \
+    do {                                                 \
+        if (Log::isEnabled(level)) {                     \
+            std::ostringstream logStream;                \
+            logStream << expr;                           \
+            Log::write(level, logStream.str());          \
+        }                                                \
+    } while (0)
+
+// Выключенный уровень: выражение проверяется компилятором, но ветка
+// мёртвая и в код не попадает
+#define LOG_DISABLED(expr)                               \
+    do {                                                 \
+        if (false) {                                     \
+            std::ostringstream logStream;                \
+            logStream << expr;                           \
+        }                                                \
+    } while (0)
+
+#if MEMORY_GAME_LOG_LEVEL <= 0
+#define LOG_DEBUG(expr) LOG_AT(LogLevel::DEBUG, expr)
+#else
+#define LOG_DEBUG(expr) LOG_DISABLED(expr)
+#endif
+
+#if MEMORY_GAME_LOG_LEVEL <= 1
+#define LOG_INFO(expr) LOG_AT(LogLevel::INFO, expr)
+#else
+#define LOG_INFO(expr) LOG_DISABLED(expr)
+#endif
+
+#if MEMORY_GAME_LOG_LEVEL <= 2
+#define LOG_WARN(expr) LOG_AT(LogLevel::WARN, expr)
+#else
+#define LOG_WARN(expr) LOG_DISABLED(expr)
+#endif
+
+#define LOG_ERROR(expr) LOG_AT(LogLevel::ERROR, expr)
+
+#endif
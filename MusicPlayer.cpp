@@ -1,4 +1,6 @@
 #include "Audio/MusicPlayer.h"
+#include "Log.h"
+#include "Trace.h"
 #include <iostream>
 
 MusicPlayer::MusicPlayer() : volume(50.0f), isPlaying(false) {
@@ -20,6 +22,7 @@ bool MusicPlayer::loadMusic(MusicTheme theme, const std::string& filepath) {
 }
 
 void MusicPlayer::play(MusicTheme theme) {
+    TRACE_SCOPE("MusicPlayer::play");
     auto it = musicFiles.find(theme);
     if (it != musicFiles.end()) {
         // Останавливаем текущую музыку
@@ -34,7 +37,7 @@ void MusicPlayer::play(MusicTheme theme) {
             currentMusic.play();
             isPlaying = true;
         } else {
-            std::cerr << "Не удалось загрузить музыку: " << it->second << std::endl;
+            LOG_ERROR("Не удалось загрузить музыку: " << it->second);
             isPlaying = false;
         }
     }
@@ -0,0 +1,103 @@
+#include "PersistenceWorker.h"
+#include "Log.h"
+#include "Trace.h"
+
+PersistenceWorker::PersistenceWorker(Database& database)
+    : database(database), writing(false), stopping(false) {
+    worker = std::thread(&PersistenceWorker::run, this);
+}
+
+PersistenceWorker::~PersistenceWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+
+    // Обратные вызовы после выхода из главного цикла уже некому показывать
+    if (!completed.empty()) {
+        LOG_DEBUG("💾 При выходе дописано результатов: " << completed.size());
+    }
+}
+
+void PersistenceWorker::run() {
+    TRACE_THREAD("persistence");
+    std::vector<PendingSave> batch;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                break;  // остановка, очередь пуста
+            }
+            batch.swap(pending);
+            writing = true;
+        }
+
+        std::vector<GameRecord> records;
+        records.reserve(batch.size());
+        for (const auto& save : batch) {
+            records.push_back(save.record);
+        }
+
+        std::vector<bool> results;
+        {
+            TRACE_SCOPE("PersistenceWorker::write");
+            database.saveGames(records, results);
+        }
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            batch[i].success = i < results.size() && results[i];
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& save : batch) {
+                completed.push_back(std::move(save));
+            }
+            writing = false;
+        }
+        batch.clear();
+        idle.notify_all();
+    }
+}
+
+void PersistenceWorker::saveGame(const GameRecord& record, Callback callback) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        PendingSave save;
+        save.record = record;
+        save.callback = std::move(callback);
+        pending.push_back(std::move(save));
+    }
+    wake.notify_one();
+}
+
+std::size_t PersistenceWorker::poll() {
+    std::vector<PendingSave> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (completed.empty()) {
+            return 0;
+        }
+        done.swap(completed);
+    }
+
+    for (const auto& save : done) {
+        if (save.callback) {
+            save.callback(save.success, save.record);
+        }
+    }
+    return done.size();
+}
+
+void PersistenceWorker::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return pending.empty() && !writing; });
+}
+
+bool PersistenceWorker::isBusy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !pending.empty() || writing || !completed.empty();
+}
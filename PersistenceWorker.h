@@ -0,0 +1,56 @@
+#ifndef PERSISTENCEWORKER_H
+#define PERSISTENCEWORKER_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Database.h"
+
+// Отложенная запись результатов в БД.
+// saveGame() только ставит запись в очередь; фоновый поток забирает всё
+// накопившееся и пишет одной транзакцией, так что fsync на медленном томе
+// не задерживает кадр. Обратные вызовы выполняются в потоке, вызвавшем
+// poll() (главный цикл игры), - из них можно трогать интерфейс.
+// Деструктор дописывает очередь до конца.
+class PersistenceWorker {
+public:
+    using Callback = std::function<void(bool success, const GameRecord& record)>;
+
+private:
+    struct PendingSave {
+        GameRecord record;
+        Callback callback;
+        bool success = false;
+    };
+
+    Database& database;
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::vector<PendingSave> pending;    // ждут записи
+    std::vector<PendingSave> completed;  // записаны, ждут poll()
+    bool writing;
+    bool stopping;
+
+    void run();
+
+public:
+    explicit PersistenceWorker(Database& database);
+    ~PersistenceWorker();
+
+    PersistenceWorker(const PersistenceWorker&) = delete;
+    PersistenceWorker& operator=(const PersistenceWorker&) = delete;
+
+    void saveGame(const GameRecord& record, Callback callback = nullptr);
+    // Вызывает обратные вызовы завершённых записей; возвращает их число
+    std::size_t poll();
+    // Ждёт записи всего, что поставлено в очередь до вызова
+    void flush();
+    // Есть записи в очереди или невызванные обратные вызовы
+    bool isBusy() const;
+};
+
+#endif
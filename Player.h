@@ -2,7 +2,6 @@
 #define PLAYER_H
 
 #include <string>
-#include <chrono>
 
 class Player {
 private:
@@ -10,9 +9,7 @@ private:
     int score;
     int moves;
     int matchedPairs;
-    std::chrono::steady_clock::time_point startTime;
-    std::chrono::steady_clock::time_point endTime;
-    bool gameFinished;
+    double elapsedSeconds;  // время, по которому посчитаны очки
 
 public:
     Player(const std::string& name);
@@ -24,9 +21,11 @@ public:
     
     void incrementMoves();
     void incrementMatchedPairs();
-    void calculateScore(int totalPairs);
+    // Время - игровое (Game::getGameSeconds), без пауз
+    void calculateScore(int totalPairs, double timeInSeconds);
+    // Та же формула без состояния - для симулятора (tools/MemorySim.cpp)
+    static int computeScore(int matchedPairs, int moves, double timeInSeconds, int totalPairs);
     void startGame();
-    void finishGame();
     double getElapsedTime() const;
     
     void displayStats() const;
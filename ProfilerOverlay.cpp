@@ -0,0 +1,90 @@
+#include "GUI/ProfilerOverlay.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+ProfilerOverlay::ProfilerOverlay()
+    : visible(false), graph(sf::Quads), budgetLine(sf::Lines, 2) {
+    panel.setPosition(10.0f, 10.0f);
+    panel.setFillColor(sf::Color(0, 0, 0, 190));
+    panel.setOutlineColor(sf::Color(255, 255, 255, 80));
+    panel.setOutlineThickness(1.0f);
+
+    text.setCharacterSize(14);
+    text.setFillColor(sf::Color::White);
+    text.setPosition(10.0f + Padding, 10.0f + Padding);
+}
+
+void ProfilerOverlay::setFont(const sf::Font& font) {
+    text.setFont(font);
+}
+
+void ProfilerOverlay::update(const FrameTiming& timing, float budgetMs) {
+    if (!visible) {
+        return;
+    }
+
+    static const std::pair<FramePhase, const char*> phases[] = {
+        {FramePhase::EVENTS, "events "},
+        {FramePhase::UPDATE, "update "},
+        {FramePhase::RENDER, "render "},
+        {FramePhase::PRESENT, "display"},
+        {FramePhase::FRAME, "frame  "}
+    };
+
+    FrameSample average = timing.getAverage();
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "F3 hide, F4 CSV   " << timing.getCount() << " frames, "
+       << average.ticks << " ticks/frame\n";
+    ss << "phase      p50     p95     p99  ms\n";
+    for (const auto& phase : phases) {
+        ss << phase.second << std::setw(8) << timing.getPercentile(phase.first, 50)
+           << std::setw(8) << timing.getPercentile(phase.first, 95)
+           << std::setw(8) << timing.getPercentile(phase.first, 99) << "\n";
+    }
+    ss << "headroom " << timing.getHeadroomMs(budgetMs) << " of " << budgetMs << " ms";
+    text.setString(ss.str());
+
+    // График под таблицей: полная высота - два бюджета кадра
+    sf::FloatRect textBounds = text.getGlobalBounds();
+    float width = FrameTiming::HistorySize * BarWidth;
+    float left = 10.0f + Padding;
+    float bottom = textBounds.top + textBounds.height + Padding + GraphHeight;
+    float scale = budgetMs > 0.0f ? GraphHeight / (2.0f * budgetMs) : 1.0f;
+
+    graph.resize(timing.getCount() * 4);
+    for (std::size_t i = 0; i < timing.getCount(); i++) {
+        float frameMs = timing.getSample(i).frameMs;
+        float height = std::min(GraphHeight, frameMs * scale);
+        sf::Color color = frameMs <= budgetMs ? sf::Color(80, 200, 120)
+                        : frameMs <= 2.0f * budgetMs ? sf::Color(230, 200, 60)
+                        : sf::Color(230, 70, 70);
+
+        float x = left + i * BarWidth;
+        sf::Vertex* quad = &graph[i * 4];
+        quad[0] = sf::Vertex(sf::Vector2f(x, bottom - height), color);
+        quad[1] = sf::Vertex(sf::Vector2f(x + BarWidth, bottom - height), color);
+        quad[2] = sf::Vertex(sf::Vector2f(x + BarWidth, bottom), color);
+        quad[3] = sf::Vertex(sf::Vector2f(x, bottom), color);
+    }
+
+    float budgetY = bottom - GraphHeight / 2.0f;
+    budgetLine[0] = sf::Vertex(sf::Vector2f(left, budgetY), sf::Color(255, 255, 255, 140));
+    budgetLine[1] = sf::Vertex(sf::Vector2f(left + width, budgetY), sf::Color(255, 255, 255, 140));
+
+    panel.setSize(sf::Vector2f(std::max(width, textBounds.width) + Padding * 2,
+                               bottom - 10.0f + Padding));
+}
+
+unsigned int ProfilerOverlay::draw(sf::RenderTarget& target) const {
+    if (!visible) {
+        return 0;
+    }
+
+    target.draw(panel);
+    target.draw(text);
+    target.draw(graph);
+    target.draw(budgetLine);
+    return 4;
+}
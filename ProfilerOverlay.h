@@ -0,0 +1,36 @@
+#ifndef PROFILEROVERLAY_H
+#define PROFILEROVERLAY_H
+
+#include <SFML/Graphics.hpp>
+#include "FrameTiming.h"
+
+// Оверлей профилировщика кадра (F3).
+// Показывает p50/p95/p99 каждой фазы кадра и график времени последних
+// кадров. Скрытый оверлей ничего не считает и не рисует - замеры фаз
+// пишет Game в FrameTiming в любом случае.
+class ProfilerOverlay {
+private:
+    static constexpr float Padding = 8.0f;
+    static constexpr float BarWidth = 1.5f;
+    static constexpr float GraphHeight = 80.0f;
+
+    bool visible;
+    sf::RectangleShape panel;
+    sf::Text text;
+    sf::VertexArray graph;       // столбик на кадр
+    sf::VertexArray budgetLine;  // бюджет кадра
+
+public:
+    ProfilerOverlay();
+
+    void setFont(const sf::Font& font);
+    void toggle() { visible = !visible; }
+    bool isVisible() const { return visible; }
+
+    // Пересобирает таблицу и график по истории кадров
+    void update(const FrameTiming& timing, float budgetMs);
+    // Возвращает число вызовов draw
+    unsigned int draw(sf::RenderTarget& target) const;
+};
+
+#endif
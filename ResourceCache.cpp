@@ -0,0 +1,122 @@
+#include "ResourceCache.h"
+#include "Log.h"
+#include "Trace.h"
+
+ResourceCache::ResourceCache(std::size_t budgetBytes)
+    : budgetBytes(budgetBytes), usedBytes(0), hits(0), misses(0) {
+}
+
+ResourceCache::Entry* ResourceCache::lookup(const std::string& key, const std::type_info& type) {
+    auto it = entries.find(key);
+    if (it == entries.end() || *it->second.type != type) {
+        misses++;
+        return nullptr;
+    }
+
+    // Поднимаем запись в начало списка LRU
+    lru.splice(lru.begin(), lru, it->second.lruPosition);
+    hits++;
+    return &it->second;
+}
+
+void ResourceCache::store(const std::string& key, std::shared_ptr<void> resource,
+                          const std::type_info& type, std::size_t bytes) {
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        usedBytes -= it->second.bytes;
+        lru.erase(it->second.lruPosition);
+        entries.erase(it);
+    }
+
+    lru.push_front(key);
+
+    Entry entry;
+    entry.resource = std::move(resource);
+    entry.type = &type;
+    entry.bytes = bytes;
+    entry.lruPosition = lru.begin();
+    entries.emplace(key, std::move(entry));
+
+    usedBytes += bytes;
+    evict();
+}
+
+void ResourceCache::evict() {
+    if (usedBytes <= budgetBytes) {
+        return;
+    }
+
+    // Идём с конца списка - от давно не использованных
+    auto it = lru.end();
+    while (usedBytes > budgetBytes && it != lru.begin()) {
+        --it;
+
+        auto entryIt = entries.find(*it);
+        if (entryIt->second.resource.use_count() > 1) {
+            continue;
+        }
+
+        LOG_INFO("🗑 Кэш: вытеснен " << *it << " (" << entryIt->second.bytes / 1024 << " КБ)");
+        usedBytes -= entryIt->second.bytes;
+        entries.erase(entryIt);
+        it = lru.erase(it);
+    }
+}
+
+std::shared_ptr<const sf::Texture> ResourceCache::getTexture(const std::string& path) {
+    const std::string key = "texture:" + path;
+    if (auto texture = find<sf::Texture>(key)) {
+        return texture;
+    }
+
+    TRACE_SCOPE("ResourceCache::loadTexture");
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromFile(path)) {
+        return nullptr;
+    }
+
+    return insert(key, texture, textureBytes(*texture));
+}
+
+void ResourceCache::setBudget(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    budgetBytes = bytes;
+    evict();
+}
+
+std::size_t ResourceCache::getBudget() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return budgetBytes;
+}
+
+std::size_t ResourceCache::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return usedBytes;
+}
+
+std::size_t ResourceCache::getEntryCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+unsigned long ResourceCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+unsigned long ResourceCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+void ResourceCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    lru.clear();
+    usedBytes = 0;
+}
+
+std::size_t ResourceCache::textureBytes(const sf::Texture& texture) {
+    sf::Vector2u size = texture.getSize();
+    return static_cast<std::size_t>(size.x) * size.y * 4;
+}
@@ -0,0 +1,73 @@
+#ifndef RESOURCECACHE_H
+#define RESOURCECACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+// Кэш ресурсов по ключу (обычно путь к файлу).
+// Выдаёт общие shared_ptr-дескрипторы, помнит порядок использования и
+// вытесняет давно не используемые записи при превышении бюджета в байтах.
+// Запись, на которую ещё кто-то ссылается, не вытесняется - память она
+// всё равно не освободит. Потокобезопасен: фоновый ThemeLoader
+// кладёт в него готовые атласы.
+class ResourceCache {
+private:
+    struct Entry {
+        std::shared_ptr<void> resource;
+        const std::type_info* type;
+        std::size_t bytes;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    std::unordered_map<std::string, Entry> entries;
+    std::list<std::string> lru;  // в начале - последние использованные
+    std::size_t budgetBytes;
+    std::size_t usedBytes;
+    unsigned long hits;
+    unsigned long misses;
+    mutable std::mutex mutex;
+
+    Entry* lookup(const std::string& key, const std::type_info& type);
+    void store(const std::string& key, std::shared_ptr<void> resource,
+               const std::type_info& type, std::size_t bytes);
+    void evict();
+
+public:
+    static const std::size_t DefaultBudgetBytes = 256 * 1024 * 1024;
+
+    explicit ResourceCache(std::size_t budgetBytes = DefaultBudgetBytes);
+
+    template <typename T>
+    std::shared_ptr<T> find(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry* entry = lookup(key, typeid(T));
+        return entry ? std::static_pointer_cast<T>(entry->resource) : nullptr;
+    }
+
+    template <typename T>
+    std::shared_ptr<T> insert(const std::string& key, std::shared_ptr<T> resource, std::size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        store(key, resource, typeid(T), bytes);
+        return resource;
+    }
+
+    // Загружает файл при первом обращении, дальше отдаёт из памяти
+    std::shared_ptr<const sf::Texture> getTexture(const std::string& path);
+
+    void setBudget(std::size_t bytes);
+    std::size_t getBudget() const;
+    std::size_t getUsedBytes() const;
+    std::size_t getEntryCount() const;
+    unsigned long getHits() const;
+    unsigned long getMisses() const;
+    void clear();
+
+    static std::size_t textureBytes(const sf::Texture& texture);
+};
+
+#endif
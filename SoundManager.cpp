@@ -1,14 +1,18 @@
 #include "Audio/SoundManager.h"
+#include "Log.h"
+#include "Trace.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <filesystem>
 #include <cmath>
+#include <cstdio>
 
 namespace fs = std::filesystem;
 
 SoundManager::SoundManager() : volume(50.0f), soundEnabled(true) {
-    std::cout << "\n🎵 === ЗАГРУЗКА ЗВУКОВ ИЗ ФАЙЛОВ ===\n" << std::endl;
+    TRACE_SCOPE("SoundManager::SoundManager");
+    LOG_INFO("🎵 === ЗАГРУЗКА ЗВУКОВ ИЗ ФАЙЛОВ ===");
     
     // Список звуков для загрузки
     std::vector<std::pair<std::string, std::string>> soundFiles = {
@@ -23,12 +27,10 @@ SoundManager::SoundManager() : volume(50.0f), soundEnabled(true) {
     int loadedFromFiles = 0;
     
     for (const auto& [soundName, filePath] : soundFiles) {
-        std::cout << "  🔍 " << soundName << " -> " << filePath;
-        
         // 1. Проверяем существует ли файл
         std::ifstream testFile(filePath, std::ios::binary);
         if (!testFile.is_open()) {
-            std::cout << " ❌ ФАЙЛ НЕ НАЙДЕН" << std::endl;
+            LOG_WARN("  🔍 " << soundName << " -> " << filePath << " ❌ ФАЙЛ НЕ НАЙДЕН");
             createFallbackSound(soundName);
             continue;
         }
@@ -49,11 +51,11 @@ SoundManager::SoundManager() : volume(50.0f), soundEnabled(true) {
             
             // Выводим информацию о загруженном звуке
             sf::Time duration = buffer.getDuration();
-            std::cout << " ✅ ЗАГРУЖЕН (" 
-                      << duration.asSeconds() << " сек, "
-                      << buffer.getSampleRate() << " Hz)" << std::endl;
+            LOG_INFO("  🔍 " << soundName << " -> " << filePath << " ✅ ЗАГРУЖЕН ("
+                     << duration.asSeconds() << " сек, "
+                     << buffer.getSampleRate() << " Hz)");
         } else {
-            std::cout << " ❌ ОШИБКА ЗАГРУЗКИ" << std::endl;
+            LOG_WARN("  🔍 " << soundName << " -> " << filePath << " ❌ ОШИБКА ЗАГРУЗКИ");
             
             // Пробуем проанализировать файл
             std::ifstream file(filePath, std::ios::binary | std::ios::ate);
@@ -65,31 +67,27 @@ SoundManager::SoundManager() : volume(50.0f), soundEnabled(true) {
                 file.read(header, 12);
                 file.close();
                 
-                std::cout << "    📏 Размер: " << size << " байт" << std::endl;
-                std::cout << "    🔧 Заголовок: ";
+                char headerHex[40] = {};
                 for (int i = 0; i < 12; i++) {
-                    printf("%02X ", (unsigned char)header[i]);
+                    std::snprintf(headerHex + i * 3, 4, "%02X ", (unsigned char)header[i]);
                 }
-                std::cout << std::endl;
                 
                 // Проверяем WAV заголовок
-                if (header[0] == 'R' && header[1] == 'I' && 
-                    header[2] == 'F' && header[3] == 'F') {
-                    std::cout << "    ✅ RIFF заголовок OK" << std::endl;
-                } else {
-                    std::cout << "    ❌ Неверный RIFF заголовок" << std::endl;
-                }
+                bool isRiff = header[0] == 'R' && header[1] == 'I' && 
+                              header[2] == 'F' && header[3] == 'F';
+                LOG_WARN("    📏 Размер: " << size << " байт, 🔧 Заголовок: " << headerHex
+                         << (isRiff ? " (RIFF заголовок OK)" : " (неверный RIFF заголовок)"));
             }
             
             createFallbackSound(soundName);
         }
     }
     
-    std::cout << "\n📊 РЕЗУЛЬТАТ: " << loadedFromFiles << " из " 
-              << soundFiles.size() << " звуков загружены из файлов\n" << std::endl;
+    LOG_INFO("📊 РЕЗУЛЬТАТ: " << loadedFromFiles << " из " 
+             << soundFiles.size() << " звуков загружены из файлов");
     
     if (loadedFromFiles < soundFiles.size()) {
-        std::cout << "⚠ Некоторые звуки не загрузились, используем заглушки\n" << std::endl;
+        LOG_WARN("⚠ Некоторые звуки не загрузились, используем заглушки");
     }
 }
 
@@ -134,8 +132,8 @@ void SoundManager::createProgrammaticSound(const std::string& name, float freque
         sound.setVolume(volume);
         sounds[name] = sound;
         
-        std::cout << "    🔊 Создана программная заглушка для " << name 
-                  << " (" << frequency << " Hz)" << std::endl;
+        LOG_INFO("    🔊 Создана программная заглушка для " << name 
+                 << " (" << frequency << " Hz)");
     }
 }
 
@@ -166,7 +164,7 @@ void SoundManager::playSound(const std::string& name) {
             it->second.stop();
         }
         it->second.play();
-        std::cout << "[PLAY] " << name << std::endl;
+        LOG_DEBUG("[PLAY] " << name);
     }
 }
 
@@ -191,7 +189,7 @@ float SoundManager::getVolume() const {
 
 void SoundManager::enableSound(bool enable) {
     soundEnabled = enable;
-    std::cout << "[SOUND] " << (enable ? "ВКЛЮЧЕН" : "ВЫКЛЮЧЕН") << std::endl;
+    LOG_INFO("[SOUND] " << (enable ? "ВКЛЮЧЕН" : "ВЫКЛЮЧЕН"));
 }
 
 bool SoundManager::isSoundEnabled() const {
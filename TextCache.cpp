@@ -0,0 +1,60 @@
+#include "GUI/TextCache.h"
+
+TextCache::TextCache()
+    : screen(-1), windowSize(0, 0), revision(0), valid(false) {
+}
+
+bool TextCache::needsRebuild(int newScreen, const sf::Vector2u& newWindowSize, unsigned int newRevision) {
+    if (valid && screen == newScreen && windowSize == newWindowSize && revision == newRevision) {
+        return false;
+    }
+
+    screen = newScreen;
+    windowSize = newWindowSize;
+    revision = newRevision;
+    valid = true;
+    texts.clear();
+    return true;
+}
+
+sf::Text& TextCache::add(const sf::String& string, const sf::Font& font, unsigned int characterSize,
+                         const sf::Color& color, sf::Uint32 style) {
+    texts.emplace_back(string, font, characterSize);
+    sf::Text& text = texts.back();
+    text.setFillColor(color);
+    text.setStyle(style);
+    return text;
+}
+
+sf::Text& TextCache::addCentered(const sf::String& string, const sf::Font& font, unsigned int characterSize,
+                                 const sf::Color& color, const sf::Vector2f& center, sf::Uint32 style) {
+    sf::Text& text = add(string, font, characterSize, color, style);
+    centerOrigin(text);
+    text.setPosition(center);
+    return text;
+}
+
+void TextCache::addShadow(const sf::Color& color, const sf::Vector2f& offset) {
+    if (texts.empty()) {
+        return;
+    }
+
+    // Копия кладётся перед оригиналом, чтобы рисоваться под ним
+    sf::Text shadow = texts.back();
+    shadow.setFillColor(color);
+    shadow.move(offset);
+    texts.insert(texts.end() - 1, shadow);
+}
+
+unsigned int TextCache::draw(sf::RenderTarget& target) const {
+    for (const auto& text : texts) {
+        target.draw(text);
+    }
+    return static_cast<unsigned int>(texts.size());
+}
+
+void TextCache::centerOrigin(sf::Text& text) {
+    sf::FloatRect bounds = text.getLocalBounds();
+    text.setOrigin(bounds.left + bounds.width / 2.0f,
+                   bounds.top + bounds.height / 2.0f);
+}
@@ -0,0 +1,43 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Готовые надписи одного экрана.
+// Тексты собираются один раз для ключа (экран, размер окна, ревизия
+// содержимого) и дальше только рисуются - без раскладки глифов и
+// выделения памяти в каждом кадре.
+class TextCache {
+private:
+    std::vector<sf::Text> texts;
+    int screen;
+    sf::Vector2u windowSize;
+    unsigned int revision;
+    bool valid;
+
+public:
+    TextCache();
+
+    // true, если ключ изменился; тогда старые тексты удалены и
+    // вызывающий должен заново наполнить кэш через add()
+    bool needsRebuild(int screen, const sf::Vector2u& windowSize, unsigned int revision);
+    void invalidate() { valid = false; }
+
+    // Ссылка действительна до следующего add()
+    sf::Text& add(const sf::String& string, const sf::Font& font, unsigned int characterSize,
+                  const sf::Color& color, sf::Uint32 style = sf::Text::Regular);
+    sf::Text& addCentered(const sf::String& string, const sf::Font& font, unsigned int characterSize,
+                          const sf::Color& color, const sf::Vector2f& center,
+                          sf::Uint32 style = sf::Text::Regular);
+    // Тень для последнего добавленного текста
+    void addShadow(const sf::Color& color, const sf::Vector2f& offset);
+
+    // Возвращает число вызовов draw
+    unsigned int draw(sf::RenderTarget& target) const;
+    std::size_t getTextCount() const { return texts.size(); }
+
+    static void centerOrigin(sf::Text& text);
+};
+
+#endif
@@ -0,0 +1,269 @@
+#include "GUI/ThemeAtlas.h"
+#include "Log.h"
+#include "Trace.h"
+#include "ResourceCache.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+ThemeAtlas::ThemeAtlas() {
+}
+
+void ThemeAtlas::clear() {
+    texture = sf::Texture();
+    imageDir.clear();
+    imagePaths.clear();
+    regions.clear();
+}
+
+const sf::IntRect* ThemeAtlas::findRegion(const std::string& imagePath) const {
+    auto it = regions.find(imagePath);
+    return it != regions.end() ? &it->second : nullptr;
+}
+
+std::vector<std::string> ThemeAtlas::scanDirectory(const std::string& imageDir) {
+    std::vector<std::string> paths;
+
+    try {
+        for (const auto& entry : fs::directory_iterator(imageDir)) {
+            if (entry.is_regular_file()) {
+                std::string ext = entry.path().extension().string();
+                std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+                if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp") {
+                    paths.push_back(entry.path().string());
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("Ошибка доступа к папке: " << e.what());
+    }
+
+    // Порядок directory_iterator не определён - сортируем для стабильного набора пар
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+sf::Image ThemeAtlas::fitToCell(const sf::Image& source, unsigned int maxSize) {
+    sf::Vector2u size = source.getSize();
+    if (size.x <= maxSize && size.y <= maxSize) {
+        return source;
+    }
+
+    // Усреднение по блокам исходных пикселей
+    float scale = static_cast<float>(maxSize) / std::max(size.x, size.y);
+    unsigned int width = std::max(1u, static_cast<unsigned int>(size.x * scale));
+    unsigned int height = std::max(1u, static_cast<unsigned int>(size.y * scale));
+
+    const sf::Uint8* src = source.getPixelsPtr();
+    std::vector<sf::Uint8> dst(static_cast<std::size_t>(width) * height * 4);
+
+    for (unsigned int y = 0; y < height; y++) {
+        unsigned int sy0 = y * size.y / height;
+        unsigned int sy1 = std::max(sy0 + 1, (y + 1) * size.y / height);
+
+        for (unsigned int x = 0; x < width; x++) {
+            unsigned int sx0 = x * size.x / width;
+            unsigned int sx1 = std::max(sx0 + 1, (x + 1) * size.x / width);
+
+            unsigned int sum[4] = {0, 0, 0, 0};
+            for (unsigned int sy = sy0; sy < sy1; sy++) {
+                const sf::Uint8* row = src + (static_cast<std::size_t>(sy) * size.x + sx0) * 4;
+                for (unsigned int sx = sx0; sx < sx1; sx++, row += 4) {
+                    sum[0] += row[0];
+                    sum[1] += row[1];
+                    sum[2] += row[2];
+                    sum[3] += row[3];
+                }
+            }
+
+            unsigned int count = (sy1 - sy0) * (sx1 - sx0);
+            sf::Uint8* out = &dst[(static_cast<std::size_t>(y) * width + x) * 4];
+            for (int c = 0; c < 4; c++) {
+                out[c] = static_cast<sf::Uint8>(sum[c] / count);
+            }
+        }
+    }
+
+    sf::Image result;
+    result.create(width, height, dst.data());
+    return result;
+}
+
+bool ThemeAtlas::pack(const std::vector<sf::Vector2u>& sizes, unsigned int maxTextureSize,
+                      sf::Vector2u& atlasSize, std::vector<sf::IntRect>& rects) {
+    rects.assign(sizes.size(), sf::IntRect());
+    atlasSize = sf::Vector2u(0, 0);
+
+    if (sizes.empty()) {
+        return true;
+    }
+
+    unsigned long long totalArea = 0;
+    unsigned int maxWidth = 0;
+    for (const auto& size : sizes) {
+        totalArea += static_cast<unsigned long long>(size.x + CellPadding) * (size.y + CellPadding);
+        maxWidth = std::max(maxWidth, size.x + CellPadding * 2);
+    }
+
+    // Полки: сначала самые высокие картинки
+    std::vector<std::size_t> order(sizes.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) {
+        return sizes[a].y > sizes[b].y;
+    });
+
+    unsigned int width = 64;
+    unsigned int minWidth = std::max(maxWidth, static_cast<unsigned int>(std::sqrt(static_cast<double>(totalArea))));
+    while (width < minWidth) {
+        width *= 2;
+    }
+
+    while (width <= maxTextureSize) {
+        unsigned int x = CellPadding;
+        unsigned int y = CellPadding;
+        unsigned int shelfHeight = 0;
+
+        for (std::size_t i : order) {
+            if (x + sizes[i].x + CellPadding > width) {
+                y += shelfHeight + CellPadding;
+                x = CellPadding;
+                shelfHeight = 0;
+            }
+
+            rects[i] = sf::IntRect(x, y, sizes[i].x, sizes[i].y);
+            x += sizes[i].x + CellPadding;
+            shelfHeight = std::max(shelfHeight, sizes[i].y);
+        }
+
+        unsigned int height = y + shelfHeight + CellPadding;
+        if (height <= maxTextureSize) {
+            atlasSize = sf::Vector2u(width, height);
+            return true;
+        }
+
+        width *= 2;
+    }
+
+    return false;
+}
+
+std::size_t ThemeAtlas::getByteSize() const {
+    return ResourceCache::textureBytes(texture);
+}
+
+bool ThemeAtlas::compose(const std::vector<sf::Image>& images, unsigned int maxTextureSize,
+                         sf::Image& atlasImage, std::vector<sf::IntRect>& rects) {
+    TRACE_SCOPE("ThemeAtlas::compose");
+    std::vector<sf::Vector2u> sizes;
+    for (const auto& image : images) {
+        sizes.push_back(image.getSize());
+    }
+
+    sf::Vector2u atlasSize;
+    if (!pack(sizes, maxTextureSize, atlasSize, rects)) {
+        return false;
+    }
+
+    atlasImage.create(atlasSize.x, atlasSize.y, sf::Color::Transparent);
+    for (std::size_t i = 0; i < images.size(); i++) {
+        atlasImage.copy(images[i], rects[i].left, rects[i].top);
+    }
+
+    return true;
+}
+
+bool ThemeAtlas::create(const std::string& dir, const std::vector<std::string>& paths,
+                        const std::vector<sf::IntRect>& rects, const sf::Vector2u& size) {
+    clear();
+    imageDir = dir;
+
+    if (paths.empty()) {
+        return true;
+    }
+
+    if (!texture.create(size.x, size.y)) {
+        LOG_ERROR("❌ Не удалось создать текстуру атласа");
+        return false;
+    }
+
+    imagePaths = paths;
+    for (std::size_t i = 0; i < paths.size(); i++) {
+        regions[paths[i]] = rects[i];
+    }
+
+    return true;
+}
+
+void ThemeAtlas::uploadRows(const sf::Image& atlasImage, unsigned int firstRow, unsigned int rowCount) {
+    sf::Vector2u size = atlasImage.getSize();
+    if (firstRow >= size.y || rowCount == 0) {
+        return;
+    }
+
+    rowCount = std::min(rowCount, size.y - firstRow);
+    const sf::Uint8* pixels = atlasImage.getPixelsPtr() + static_cast<std::size_t>(firstRow) * size.x * 4;
+    texture.update(pixels, size.x, rowCount, 0, firstRow);
+}
+
+bool ThemeAtlas::decodeCell(const std::string& path, sf::Image& cell) {
+    TRACE_SCOPE("ThemeAtlas::decodeCell");
+    sf::Image image;
+    if (!image.loadFromFile(path)) {
+        return false;
+    }
+    cell = fitToCell(image, MaxCellSize);
+    return true;
+}
+
+bool ThemeAtlas::build(const std::string& dir) {
+    TRACE_SCOPE("ThemeAtlas::build");
+    clear();
+
+    LOG_INFO("🧩 Сборка атласа темы: " << dir);
+
+    std::vector<std::string> paths = scanDirectory(dir);
+    std::vector<std::string> loadedPaths;
+    std::vector<sf::Image> images;
+
+    for (const auto& path : paths) {
+        sf::Image cell;
+        if (!decodeCell(path, cell)) {
+            LOG_WARN("⚠ Не удалось загрузить изображение: " << path);
+            continue;
+        }
+
+        images.push_back(std::move(cell));
+        loadedPaths.push_back(path);
+    }
+
+    if (images.empty()) {
+        LOG_WARN("Изображения не найдены");
+        imageDir = dir;
+        return false;
+    }
+
+    sf::Image atlasImage;
+    std::vector<sf::IntRect> rects;
+    if (!compose(images, sf::Texture::getMaximumSize(), atlasImage, rects)) {
+        LOG_ERROR("❌ Изображения темы не помещаются в одну текстуру");
+        imageDir = dir;
+        return false;
+    }
+
+    if (!create(dir, loadedPaths, rects, atlasImage.getSize())) {
+        imagePaths.clear();
+        regions.clear();
+        return false;
+    }
+
+    uploadRows(atlasImage, 0, atlasImage.getSize().y);
+
+    LOG_INFO("✅ Атлас: " << images.size() << " изображений, "
+             << atlasImage.getSize().x << "x" << atlasImage.getSize().y);
+    return true;
+}
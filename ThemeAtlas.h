@@ -0,0 +1,55 @@
+#ifndef THEMEATLAS_H
+#define THEMEATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+// Все изображения темы (assets/images/<theme>/), упакованные в одну текстуру.
+// Карточки ссылаются на свой прямоугольник внутри атласа вместо
+// собственной текстуры, поэтому каждая картинка декодируется один раз.
+// Готовые атласы хранятся в ResourceCache; исходные изображения нужны
+// только на время упаковки и в кэш не попадают.
+class ThemeAtlas {
+private:
+    sf::Texture texture;
+    std::string imageDir;
+    std::vector<std::string> imagePaths;
+    std::map<std::string, sf::IntRect> regions;
+
+public:
+    // Картинки крупнее ячейки уменьшаются: карточка всё равно показывает их в ~64px
+    static const unsigned int MaxCellSize = 256;
+    static const unsigned int CellPadding = 2;
+
+    ThemeAtlas();
+
+    bool build(const std::string& imageDir);
+    void clear();
+    
+    // Пошаговая сборка (ThemeLoader): разметка уже готова, пиксели
+    // догружаются в текстуру полосами из главного потока
+    bool create(const std::string& dir, const std::vector<std::string>& paths,
+                const std::vector<sf::IntRect>& rects, const sf::Vector2u& size);
+    void uploadRows(const sf::Image& atlasImage, unsigned int firstRow, unsigned int rowCount);
+
+    bool isBuiltFor(const std::string& dir) const { return !imageDir.empty() && imageDir == dir; }
+    const sf::IntRect* findRegion(const std::string& imagePath) const;
+    const sf::Texture& getTexture() const { return texture; }
+    const std::vector<std::string>& getImagePaths() const { return imagePaths; }
+    std::size_t getImageCount() const { return regions.size(); }
+    std::size_t getByteSize() const;
+
+    // Этапы сборки без обращения к OpenGL
+    static std::vector<std::string> scanDirectory(const std::string& imageDir);
+    static sf::Image fitToCell(const sf::Image& source, unsigned int maxSize);
+    // Декодирует файл и сразу уменьшает до ячейки (MaxCellSize)
+    static bool decodeCell(const std::string& path, sf::Image& cell);
+    static bool pack(const std::vector<sf::Vector2u>& sizes, unsigned int maxTextureSize,
+                     sf::Vector2u& atlasSize, std::vector<sf::IntRect>& rects);
+    static bool compose(const std::vector<sf::Image>& images, unsigned int maxTextureSize,
+                        sf::Image& atlasImage, std::vector<sf::IntRect>& rects);
+};
+
+#endif
@@ -0,0 +1,182 @@
+#include "GUI/ThemeLoader.h"
+#include "Log.h"
+#include "ResourceCache.h"
+#include "Trace.h"
+#include <algorithm>
+
+ThemeLoader::ThemeLoader(ResourceCache& cache)
+    : cache(cache), status(Status::IDLE), cancelled(false),
+      totalImages(0), decodedImages(0), maxTextureSize(0), uploadedRows(0) {
+}
+
+ThemeLoader::~ThemeLoader() {
+    cancel();
+}
+
+void ThemeLoader::start(const std::string& dir) {
+    // Та же тема уже грузится или готова
+    if (dir == imageDir && status != Status::IDLE && status != Status::FAILED) {
+        return;
+    }
+
+    cancel();
+
+    imageDir = dir;
+    loadedPaths.clear();
+    rects.clear();
+    atlasImage = sf::Image();
+    atlas.reset();
+    uploadedRows = 0;
+    totalImages = 0;
+    decodedImages = 0;
+    cancelled = false;
+    status = Status::DECODING;
+
+    // Лимит спрашиваем здесь: рабочий поток не должен трогать OpenGL
+    maxTextureSize = sf::Texture::getMaximumSize();
+
+    LOG_INFO("⏳ Фоновая загрузка темы: " << dir);
+    worker = std::thread(&ThemeLoader::run, this, dir);
+}
+
+void ThemeLoader::cancel() {
+    if (worker.joinable()) {
+        cancelled = true;
+        worker.join();
+    }
+
+    if (status == Status::DECODING || status == Status::UPLOADING) {
+        status = Status::IDLE;
+    }
+}
+
+void ThemeLoader::run(std::string dir) {
+    TRACE_THREAD("theme loader");
+    TRACE_SCOPE("ThemeLoader::run");
+    std::vector<std::string> paths = ThemeAtlas::scanDirectory(dir);
+    totalImages = paths.size();
+
+    std::vector<sf::Image> cells(paths.size());
+    std::vector<char> decoded(paths.size(), 0);
+    std::atomic<std::size_t> nextIndex(0);
+
+    auto decodeImages = [&]() {
+        TRACE_SCOPE("ThemeLoader::decodeImages");
+        while (!cancelled) {
+            std::size_t i = nextIndex++;
+            if (i >= paths.size()) {
+                break;
+            }
+
+            // Полноразмерный образ живёт только до уменьшения: в кэш
+            // попадает готовый атлас, а не каждая картинка
+            if (ThemeAtlas::decodeCell(paths[i], cells[i])) {
+                decoded[i] = 1;
+            }
+            decodedImages++;
+        }
+    };
+
+    // Декодирование параллельно; этот поток тоже участвует
+    unsigned int threadCount = std::max(1u, std::min(4u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> helpers;
+    for (unsigned int t = 1; t < threadCount && t < paths.size(); t++) {
+        helpers.emplace_back([&decodeImages]() {
+            TRACE_THREAD("theme decode");
+            decodeImages();
+        });
+    }
+    decodeImages();
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+
+    if (cancelled) {
+        return;
+    }
+
+    std::vector<sf::Image> images;
+    for (std::size_t i = 0; i < paths.size(); i++) {
+        if (decoded[i]) {
+            images.push_back(std::move(cells[i]));
+            loadedPaths.push_back(paths[i]);
+        } else {
+            LOG_WARN("⚠ Не удалось загрузить изображение: " << paths[i]);
+        }
+    }
+
+    if (!images.empty() && !ThemeAtlas::compose(images, maxTextureSize, atlasImage, rects)) {
+        LOG_ERROR("❌ Изображения темы не помещаются в одну текстуру");
+        status = Status::FAILED;
+        return;
+    }
+
+    status = Status::UPLOADING;
+}
+
+bool ThemeLoader::poll() {
+    if (status != Status::UPLOADING) {
+        return false;
+    }
+
+    TRACE_SCOPE("ThemeLoader::poll");
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    // Текстура создаётся и заполняется только в главном потоке (контекст OpenGL)
+    if (!atlas) {
+        atlas = std::make_shared<ThemeAtlas>();
+        if (!atlas->create(imageDir, loadedPaths, rects, atlasImage.getSize())) {
+            atlas.reset();
+            status = Status::FAILED;
+            return false;
+        }
+    }
+
+    unsigned int height = loadedPaths.empty() ? 0 : atlasImage.getSize().y;
+    if (uploadedRows < height) {
+        atlas->uploadRows(atlasImage, uploadedRows, RowsPerPoll);
+        uploadedRows = std::min(height, uploadedRows + RowsPerPoll);
+    }
+
+    if (uploadedRows < height) {
+        return false;
+    }
+
+    // Образ в памяти больше не нужен - атлас уходит в общий кэш
+    atlasImage = sf::Image();
+    cache.insert("atlas:" + imageDir, atlas, atlas->getByteSize());
+    status = Status::READY;
+
+    LOG_INFO("✅ Тема загружена: " << imageDir << " (" << loadedPaths.size() << " изображений)");
+    return true;
+}
+
+bool ThemeLoader::isLoading(const std::string& dir) const {
+    Status current = status;
+    return dir == imageDir && (current == Status::DECODING || current == Status::UPLOADING);
+}
+
+bool ThemeLoader::isReady(const std::string& dir) const {
+    return dir == imageDir && status == Status::READY;
+}
+
+float ThemeLoader::getProgress() const {
+    Status current = status;
+    if (current == Status::READY) {
+        return 1.0f;
+    }
+
+    // 80% - декодирование, 20% - выгрузка в текстуру
+    std::size_t total = totalImages;
+    float decodeProgress = total > 0 ? static_cast<float>(decodedImages) / total : 0.0f;
+
+    if (current == Status::UPLOADING) {
+        unsigned int height = atlasImage.getSize().y;
+        float uploadProgress = height > 0 ? static_cast<float>(uploadedRows) / height : 1.0f;
+        return 0.8f + 0.2f * uploadProgress;
+    }
+
+    return 0.8f * decodeProgress;
+}
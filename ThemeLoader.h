@@ -0,0 +1,67 @@
+#ifndef THEMELOADER_H
+#define THEMELOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GUI/ThemeAtlas.h"
+
+class ResourceCache;
+
+// Фоновая загрузка темы.
+// Сканирование папки, декодирование и упаковка изображений идут в рабочих
+// потоках; готовый образ атласа догружается в текстуру полосами из
+// главного цикла (poll), чтобы окно не замирало на медленном диске.
+class ThemeLoader {
+public:
+    enum class Status {
+        IDLE,
+        DECODING,
+        UPLOADING,
+        READY,
+        FAILED
+    };
+
+private:
+    ResourceCache& cache;
+    std::string imageDir;
+
+    std::thread worker;
+    std::atomic<Status> status;
+    std::atomic<bool> cancelled;
+    std::atomic<std::size_t> totalImages;
+    std::atomic<std::size_t> decodedImages;
+    unsigned int maxTextureSize;
+
+    // Результат рабочего потока; читается главным потоком после DECODING
+    std::vector<std::string> loadedPaths;
+    std::vector<sf::IntRect> rects;
+    sf::Image atlasImage;
+
+    std::shared_ptr<ThemeAtlas> atlas;
+    unsigned int uploadedRows;
+
+    void run(std::string dir);
+
+public:
+    // Сколько строк атласа выгружать в текстуру за один кадр
+    static const unsigned int RowsPerPoll = 128;
+
+    explicit ThemeLoader(ResourceCache& cache);
+    ~ThemeLoader();
+
+    void start(const std::string& imageDir);
+    void cancel();
+    bool poll();
+
+    Status getStatus() const { return status; }
+    bool isLoading(const std::string& dir) const;
+    bool isReady(const std::string& dir) const;
+    float getProgress() const;
+    std::shared_ptr<ThemeAtlas> getAtlas() const { return atlas; }
+};
+
+#endif
@@ -0,0 +1,167 @@
+#include "Trace.h"
+#include "Log.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    struct TraceEvent {
+        const char* name;
+        std::int64_t startNs;
+        std::int64_t endNs;
+    };
+
+    // Буфер пишет только свой поток; замок нужен для stop() из другого потока
+    // и почти всегда свободен
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<TraceEvent> events;
+        std::string name;
+        int tid = 0;
+    };
+
+    std::mutex registryMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;  // живут дольше потоков
+    std::string outputPath;
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    ThreadBuffer& getThreadBuffer() {
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+        if (!buffer) {
+            buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(registryMutex);
+            buffer->tid = static_cast<int>(buffers.size()) + 1;
+            buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    void writeJsonString(std::ostream& out, const std::string& value) {
+        out << '"';
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out << escaped;
+            } else {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+
+    // Микросекунды с точностью до наносекунд - единица формата
+    void writeMicros(std::ostream& out, std::int64_t ns) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%lld.%03lld",
+                      static_cast<long long>(ns / 1000), static_cast<long long>(ns % 1000));
+        out << buffer;
+    }
+}
+
+std::atomic<bool> Trace::enabled(false);
+
+bool Trace::isCompiledIn() {
+#ifdef MEMORY_GAME_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::int64_t Trace::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+bool Trace::start(const std::string& path) {
+    if (!isCompiledIn()) {
+        LOG_WARN("⚠ Трассировка не собрана: включите опцию MEMORY_GAME_TRACING");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto& buffer : buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+    }
+    outputPath = path;
+    enabled = true;
+
+    LOG_INFO("⏺ Трассировка включена, файл: " << path);
+    return true;
+}
+
+bool Trace::stop() {
+    if (!enabled.exchange(false)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::ofstream out(outputPath);
+    if (!out) {
+        LOG_ERROR("❌ Не удалось записать трассу: " << outputPath);
+        return false;
+    }
+
+    std::size_t total = 0;
+    bool first = true;
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+
+    for (auto& buffer : buffers) {
+        std::vector<TraceEvent> events;
+        std::string name;
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            events.swap(buffer->events);
+            name = buffer->name;
+        }
+
+        if (!name.empty()) {
+            out << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+                << buffer->tid << ", \"args\": {\"name\": ";
+            writeJsonString(out, name);
+            out << "}}";
+            first = false;
+        }
+
+        for (const auto& event : events) {
+            out << (first ? "" : ",\n") << "{\"name\": ";
+            writeJsonString(out, event.name);
+            out << ", \"cat\": \"game\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->tid << ", \"ts\": ";
+            writeMicros(out, event.startNs);
+            out << ", \"dur\": ";
+            writeMicros(out, event.endNs - event.startNs);
+            out << "}";
+            first = false;
+        }
+        total += events.size();
+    }
+
+    out << "\n]}\n";
+    LOG_INFO("⏹ Трасса записана: " << outputPath << " (" << total << " событий)");
+    return static_cast<bool>(out);
+}
+
+void Trace::record(const char* name, std::int64_t startNs, std::int64_t endNs) {
+    // Область, начатая до stop(), после него не пишется
+    if (!isEnabled()) {
+        return;
+    }
+
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back({name, startNs, endNs});
+}
+
+void Trace::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
@@ -0,0 +1,60 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Трассировка в формате Chrome trace event (Perfetto, chrome://tracing).
+// TRACE_SCOPE("имя") отмечает время от объявления до конца блока. События
+// копятся в буфере своего потока и пишутся в JSON при Trace::stop().
+// Без опции MEMORY_GAME_TRACING макросы пустые; в сборке с трассировкой
+// выключенная запись стоит одной проверки флага на область.
+class Trace {
+private:
+    static std::atomic<bool> enabled;
+
+public:
+    // Начинает запись; файл path пишется при stop()
+    static bool start(const std::string& path);
+    static bool stop();
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static bool isCompiledIn();
+
+    // Наносекунды от запуска программы
+    static std::int64_t now();
+    static void record(const char* name, std::int64_t startNs, std::int64_t endNs);
+    // Имя текущего потока в трассе
+    static void setThreadName(const std::string& name);
+};
+
+class TraceScope {
+private:
+    const char* name;   // строковый литерал - хранится только указатель
+    std::int64_t startNs;
+
+public:
+    explicit TraceScope(const char* name)
+        : name(name), startNs(Trace::isEnabled() ? Trace::now() : -1) {}
+
+    ~TraceScope() {
+        if (startNs >= 0) {
+            Trace::record(name, startNs, Trace::now());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#ifdef MEMORY_GAME_TRACING
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_THREAD(name) Trace::setThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_THREAD(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,120 @@
+#include "BoardEngine.h"
+#include <cstdint>
+#include <random>
+#include <utility>
+
+BoardEngine::BoardEngine()
+    : rows(0), cols(0), totalPairs(0), matchedPairs(0), moves(0),
+      firstIndex(-1), secondIndex(-1), mismatchPending(false) {
+}
+
+bool BoardEngine::reset(int newRows, int newCols, std::vector<std::uint16_t> newPairIds) {
+    if (newRows <= 0 || newCols <= 0 ||
+        newPairIds.size() != static_cast<std::size_t>(newRows) * newCols ||
+        newPairIds.size() % 2 != 0) {
+        return false;
+    }
+
+    rows = newRows;
+    cols = newCols;
+    pairIds = std::move(newPairIds);
+    states.assign(pairIds.size(), 0);
+    totalPairs = static_cast<int>(pairIds.size() / 2);
+    matchedPairs = 0;
+    moves = 0;
+    firstIndex = -1;
+    secondIndex = -1;
+    mismatchPending = false;
+    return true;
+}
+
+bool BoardEngine::deal(int newRows, int newCols, std::vector<std::uint16_t> newPairIds, std::uint64_t seed) {
+    shuffle(newPairIds, seed);
+    return reset(newRows, newCols, std::move(newPairIds));
+}
+
+std::vector<std::uint16_t> BoardEngine::makePairs(const std::vector<std::uint16_t>& symbols, int totalPairs) {
+    std::vector<std::uint16_t> result;
+    if (symbols.empty() || totalPairs <= 0) {
+        return result;
+    }
+
+    result.reserve(static_cast<std::size_t>(totalPairs) * 2);
+    for (int i = 0; i < totalPairs; i++) {
+        std::uint16_t symbol = symbols[i % symbols.size()];
+        result.push_back(symbol);
+        result.push_back(symbol);
+    }
+    return result;
+}
+
+void BoardEngine::shuffle(std::vector<std::uint16_t>& values, std::uint64_t seed) {
+    // Выход mt19937_64 задан стандартом; индекс берётся отбрасыванием
+    // хвоста, чтобы не было смещения остатка от деления
+    std::mt19937_64 rng(seed);
+    for (std::size_t i = values.size(); i > 1; i--) {
+        std::uint64_t bound = i;
+        std::uint64_t limit = UINT64_MAX - UINT64_MAX % bound;
+        std::uint64_t r;
+        do {
+            r = rng();
+        } while (r >= limit);
+        std::swap(values[i - 1], values[static_cast<std::size_t>(r % bound)]);
+    }
+}
+
+bool BoardEngine::canSelect(int index) const {
+    if (index < 0 || index >= getCardCount()) {
+        return false;
+    }
+
+    // Пока открыта пара, новый выбор недоступен
+    return secondIndex < 0 && states[index] == 0;
+}
+
+BoardEngine::SelectResult BoardEngine::selectCard(int index) {
+    if (!canSelect(index)) {
+        return SelectResult::IGNORED;
+    }
+
+    states[index] |= FaceUp;
+
+    if (firstIndex < 0) {
+        firstIndex = index;
+        return SelectResult::FIRST;
+    }
+
+    secondIndex = index;
+    moves++;
+    return SelectResult::SECOND;
+}
+
+BoardEngine::Outcome BoardEngine::resolve() {
+    if (firstIndex < 0 || secondIndex < 0 || mismatchPending) {
+        return Outcome::NONE;
+    }
+
+    if (pairIds[firstIndex] == pairIds[secondIndex]) {
+        states[firstIndex] |= Matched;
+        states[secondIndex] |= Matched;
+        matchedPairs++;
+        firstIndex = -1;
+        secondIndex = -1;
+        return Outcome::MATCH;
+    }
+
+    mismatchPending = true;
+    return Outcome::MISMATCH;
+}
+
+void BoardEngine::hideMismatch() {
+    if (!mismatchPending) {
+        return;
+    }
+
+    states[firstIndex] &= static_cast<std::uint8_t>(~FaceUp);
+    states[secondIndex] &= static_cast<std::uint8_t>(~FaceUp);
+    firstIndex = -1;
+    secondIndex = -1;
+    mismatchPending = false;
+}
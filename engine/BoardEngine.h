@@ -0,0 +1,77 @@
+#ifndef BOARDENGINE_H
+#define BOARDENGINE_H
+
+#include <cstdint>
+#include <vector>
+
+// Правила игры без графики.
+// Поле хранится параллельными массивами: номер пары и биты состояния на
+// каждую карту. Ход - выбор двух карт (selectCard), затем resolve():
+// совпавшие остаются открытыми, несовпавшие закрывает hideMismatch().
+// Паузы между шагами задаёт интерфейс, движок от времени не зависит.
+class BoardEngine {
+public:
+    // Биты состояния карты
+    static const std::uint8_t FaceUp = 1;
+    static const std::uint8_t Matched = 2;
+
+    enum class SelectResult {
+        IGNORED,  // карту сейчас выбрать нельзя
+        FIRST,
+        SECOND    // ход завершён, нужен resolve()
+    };
+
+    enum class Outcome {
+        NONE,     // нечего сравнивать
+        MATCH,
+        MISMATCH  // карты открыты до hideMismatch()
+    };
+
+private:
+    std::vector<std::uint16_t> pairIds;
+    std::vector<std::uint8_t> states;
+    int rows, cols;
+    int totalPairs;
+    int matchedPairs;
+    int moves;
+    int firstIndex;
+    int secondIndex;
+    bool mismatchPending;
+
+public:
+    BoardEngine();
+
+    // pairIds - номер пары для каждой карты в порядке раскладки (строками)
+    bool reset(int rows, int cols, std::vector<std::uint16_t> pairIds);
+    // То же, но карты сначала перемешиваются по зерну: одно зерно - одна раскладка
+    bool deal(int rows, int cols, std::vector<std::uint16_t> pairIds, std::uint64_t seed);
+
+    // Карты по парам: пара i получает символ symbols[i % symbols.size()]
+    static std::vector<std::uint16_t> makePairs(const std::vector<std::uint16_t>& symbols, int totalPairs);
+    // Перемешивание Фишера-Йетса поверх mt19937_64. std::shuffle и
+    // распределения <random> отличаются между библиотеками, поэтому свои
+    static void shuffle(std::vector<std::uint16_t>& values, std::uint64_t seed);
+
+    SelectResult selectCard(int index);
+    Outcome resolve();
+    void hideMismatch();
+
+    bool canSelect(int index) const;
+    bool isFaceUp(int index) const { return (states[index] & FaceUp) != 0; }
+    bool isMatched(int index) const { return (states[index] & Matched) != 0; }
+    std::uint16_t getPairId(int index) const { return pairIds[index]; }
+    std::uint8_t getState(int index) const { return states[index]; }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getCardCount() const { return static_cast<int>(pairIds.size()); }
+    int getTotalPairs() const { return totalPairs; }
+    int getMatchedPairs() const { return matchedPairs; }
+    int getMoves() const { return moves; }
+    int getFirstSelected() const { return firstIndex; }
+    int getSecondSelected() const { return secondIndex; }
+    bool hasMismatchPending() const { return mismatchPending; }
+    bool isComplete() const { return totalPairs > 0 && matchedPairs >= totalPairs; }
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef DIFFICULTY_H
+#define DIFFICULTY_H
+
+// Уровни сложности и размеры поля.
+// Без SFML: общие для игры, движка и симулятора.
+enum class Difficulty {
+    EASY,    // 3x4 = 12 cards (6 pairs)
+    MEDIUM,  // 4x4 = 16 cards (8 pairs)
+    HARD,    // 4x6 = 24 cards (12 pairs)
+    EXPERT,  // 6x6 = 36 cards (18 pairs)
+    CUSTOM   // rows x cols, задаются отдельно (getCustomBoardSize)
+};
+
+struct BoardSize {
+    int rows;
+    int cols;
+    int totalPairs;
+};
+
+// Пределы своего поля: номера карт и пар - 16-битные
+const int MinBoardSide = 2;
+const int MaxBoardSide = 128;
+const int DefaultCustomSide = 10;
+
+// Размер своего поля: стороны ограничиваются пределами, а при нечётном
+// числе карт убирается один столбец
+inline BoardSize getCustomBoardSize(int rows, int cols) {
+    rows = rows < MinBoardSide ? MinBoardSide : (rows > MaxBoardSide ? MaxBoardSide : rows);
+    cols = cols < MinBoardSide ? MinBoardSide : (cols > MaxBoardSide ? MaxBoardSide : cols);
+    if ((rows * cols) % 2 != 0) {
+        cols--;
+    }
+    return {rows, cols, rows * cols / 2};
+}
+
+inline BoardSize getBoardSize(Difficulty difficulty) {
+    switch (difficulty) {
+        case Difficulty::EASY: return {3, 4, 6};
+        case Difficulty::MEDIUM: return {4, 4, 8};
+        case Difficulty::HARD: return {4, 6, 12};
+        case Difficulty::EXPERT: return {6, 6, 18};
+        case Difficulty::CUSTOM: return getCustomBoardSize(DefaultCustomSide, DefaultCustomSide);
+    }
+    return {0, 0, 0};
+}
+
+inline const char* getDifficultyName(Difficulty difficulty) {
+    switch (difficulty) {
+        case Difficulty::EASY: return "Easy";
+        case Difficulty::MEDIUM: return "Medium";
+        case Difficulty::HARD: return "Hard";
+        case Difficulty::EXPERT: return "Expert";
+        case Difficulty::CUSTOM: return "Custom";
+    }
+    return "Unknown";
+}
+
+#endif
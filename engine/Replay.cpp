@@ -0,0 +1,243 @@
+#include "Replay.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    const char Magic[3] = {'M', 'G', 'R'};
+    const std::uint8_t FormatVersion = 1;
+    const std::uint64_t ResultKey = 1;
+
+    class ByteReader {
+    private:
+        const std::vector<char>& data;
+        std::size_t pos;
+
+    public:
+        explicit ByteReader(const std::vector<char>& data) : data(data), pos(0) {}
+
+        bool atEnd() const { return pos >= data.size(); }
+
+        bool readByte(std::uint8_t& value) {
+            if (atEnd()) {
+                return false;
+            }
+            value = static_cast<std::uint8_t>(data[pos++]);
+            return true;
+        }
+
+        bool readVarint(std::uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                std::uint8_t byte;
+                if (!readByte(byte)) {
+                    return false;
+                }
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool readInt(int& value) {
+            std::uint64_t raw;
+            if (!readVarint(raw) || raw > 0x7FFFFFFF) {
+                return false;
+            }
+            value = static_cast<int>(raw);
+            return true;
+        }
+
+        bool readString(std::string& value) {
+            std::uint64_t length;
+            if (!readVarint(length) || length > data.size() - pos) {
+                return false;
+            }
+            value.assign(data.begin() + pos, data.begin() + pos + length);
+            pos += length;
+            return true;
+        }
+    };
+}
+
+ReplayWriter::ReplayWriter() : lastIndex(0), lastTimeMs(0) {
+}
+
+void ReplayWriter::writeVarint(std::uint64_t value) {
+    char buffer[10];
+    int size = 0;
+    do {
+        std::uint8_t byte = value & 0x7F;
+        value >>= 7;
+        buffer[size++] = static_cast<char>(value ? byte | 0x80 : byte);
+    } while (value);
+    out.write(buffer, size);
+}
+
+void ReplayWriter::writeString(const std::string& value) {
+    writeVarint(value.size());
+    out.write(value.data(), value.size());
+}
+
+bool ReplayWriter::open(const std::string& path, const ReplayHeader& header) {
+    close();
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    lastIndex = 0;
+    lastTimeMs = 0;
+
+    out.write(Magic, sizeof(Magic));
+    out.put(static_cast<char>(FormatVersion));
+    writeVarint(header.seed);
+    writeVarint(header.rows);
+    writeVarint(header.cols);
+    writeVarint(header.symbolCount);
+    writeString(header.difficulty);
+    writeString(header.playerName);
+    return static_cast<bool>(out);
+}
+
+void ReplayWriter::recordSelect(int cardIndex, std::uint32_t timeMs) {
+    if (!out.is_open()) {
+        return;
+    }
+
+    // Соседние карты и частые клики дают разницы в один байт
+    writeVarint(Replay::zigzag(static_cast<std::int64_t>(cardIndex) - lastIndex) << 1);
+    writeVarint(timeMs >= lastTimeMs ? timeMs - lastTimeMs : 0);
+    lastIndex = cardIndex;
+    lastTimeMs = std::max(lastTimeMs, timeMs);
+}
+
+void ReplayWriter::finish(const ReplayResult& result) {
+    if (!out.is_open()) {
+        return;
+    }
+
+    writeVarint(ResultKey);
+    writeVarint(result.outcome);
+    writeVarint(result.moves);
+    writeVarint(result.matchedPairs);
+    writeVarint(result.elapsedSeconds);
+    writeVarint(result.score);
+    close();
+}
+
+void ReplayWriter::close() {
+    if (out.is_open()) {
+        out.close();
+    }
+}
+
+bool Replay::load(const std::string& path, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "не удалось открыть файл";
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    ByteReader reader(data);
+    std::uint8_t magic[3];
+    std::uint8_t version;
+    for (auto& byte : magic) {
+        if (!reader.readByte(byte)) {
+            error = "файл обрезан";
+            return false;
+        }
+    }
+    if (magic[0] != Magic[0] || magic[1] != Magic[1] || magic[2] != Magic[2] ||
+        !reader.readByte(version) || version != FormatVersion) {
+        error = "не файл повтора или неизвестная версия";
+        return false;
+    }
+
+    if (!reader.readVarint(header.seed) || !reader.readInt(header.rows) ||
+        !reader.readInt(header.cols) || !reader.readInt(header.symbolCount) ||
+        !reader.readString(header.difficulty) || !reader.readString(header.playerName)) {
+        error = "повреждён заголовок";
+        return false;
+    }
+
+    inputs.clear();
+    finished = false;
+    std::int64_t index = 0;
+    std::uint64_t timeMs = 0;
+
+    // Незавершённая партия (игру закрыли) обрывается без записи итога
+    while (!reader.atEnd()) {
+        std::uint64_t key;
+        if (!reader.readVarint(key)) {
+            error = "повреждена запись хода";
+            return false;
+        }
+
+        if (key == ResultKey) {
+            if (!reader.readInt(result.outcome) || !reader.readInt(result.moves) ||
+                !reader.readInt(result.matchedPairs) || !reader.readInt(result.elapsedSeconds) ||
+                !reader.readInt(result.score)) {
+                error = "повреждён итог партии";
+                return false;
+            }
+            finished = true;
+            break;
+        }
+
+        std::uint64_t deltaMs;
+        if ((key & 1) != 0 || !reader.readVarint(deltaMs)) {
+            error = "повреждена запись хода";
+            return false;
+        }
+        index += unzigzag(key >> 1);
+        timeMs += deltaMs;
+        inputs.push_back({static_cast<int>(index), static_cast<std::uint32_t>(timeMs)});
+    }
+
+    return true;
+}
+
+bool Replay::deal(BoardEngine& board) const {
+    if (header.symbolCount <= 0 || header.rows <= 0 || header.cols <= 0) {
+        return false;
+    }
+
+    // Номера пар в игре - номера символов темы; для правил важно только,
+    // какие пары делят символ, поэтому хватает номеров 0..symbolCount-1
+    std::vector<std::uint16_t> symbols;
+    for (int i = 0; i < header.symbolCount && i < 0xFFFF; i++) {
+        symbols.push_back(static_cast<std::uint16_t>(i));
+    }
+
+    int totalPairs = header.rows * header.cols / 2;
+    return board.deal(header.rows, header.cols, BoardEngine::makePairs(symbols, totalPairs), header.seed);
+}
+
+bool Replay::run(BoardEngine& board, std::size_t& failedInput) const {
+    if (!deal(board)) {
+        failedInput = 0;
+        return false;
+    }
+
+    // Порядок вызовов как в Game: выбор, resolve после второй карты,
+    // hideMismatch перед следующим выбором (игра ждёт mismatchDelay)
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+        if (board.hasMismatchPending()) {
+            board.hideMismatch();
+        }
+
+        BoardEngine::SelectResult selected = board.selectCard(inputs[i].cardIndex);
+        if (selected == BoardEngine::SelectResult::IGNORED) {
+            failedInput = i;
+            return false;
+        }
+        if (selected == BoardEngine::SelectResult::SECOND) {
+            board.resolve();
+        }
+    }
+
+    return true;
+}
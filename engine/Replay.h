@@ -0,0 +1,84 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "BoardEngine.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Запись партии для повтора.
+// Раскладку задаёт зерно (BoardEngine::deal), поэтому в файле только
+// заголовок, выбранные карты и итог. Формат файла (.mgr):
+//   "MGR" + версия (1 байт)
+//   заголовок: varint seed, rows, cols, symbolCount; строки difficulty, player
+//   записи: varint key; чётный key - выбор карты, key >> 1 - zigzag разницы
+//           с прошлым номером карты, за ним varint миллисекунд с прошлого выбора;
+//           key = 1 - итог партии (ReplayResult), дальше записей нет
+// Строка - varint длины и байты. Все числа - беззнаковый LEB128.
+struct ReplayHeader {
+    std::uint64_t seed = 0;
+    int rows = 0;
+    int cols = 0;
+    int symbolCount = 0;      // сколько символов темы делили пары
+    std::string difficulty;   // как в таблице games
+    std::string playerName;
+};
+
+struct ReplayInput {
+    int cardIndex;
+    std::uint32_t timeMs;     // от начала партии
+};
+
+struct ReplayResult {
+    enum Outcome { WON = 1, SURRENDERED = 2 };
+
+    int outcome = 0;
+    int moves = 0;
+    int matchedPairs = 0;
+    int elapsedSeconds = 0;   // время, по которому считались очки
+    int score = 0;            // очки игрока до деления при сдаче
+};
+
+class ReplayWriter {
+private:
+    std::ofstream out;
+    int lastIndex;
+    std::uint32_t lastTimeMs;
+
+    void writeVarint(std::uint64_t value);
+    void writeString(const std::string& value);
+
+public:
+    ReplayWriter();
+
+    bool open(const std::string& path, const ReplayHeader& header);
+    // Только выборы, принятые движком
+    void recordSelect(int cardIndex, std::uint32_t timeMs);
+    void finish(const ReplayResult& result);
+    void close();
+    bool isOpen() const { return out.is_open(); }
+};
+
+struct Replay {
+    ReplayHeader header;
+    std::vector<ReplayInput> inputs;
+    bool finished = false;
+    ReplayResult result;
+
+    bool load(const std::string& path, std::string& error);
+
+    // Исходная раскладка: те же makePairs и deal, что и в игре
+    bool deal(BoardEngine& board) const;
+    // Повтор всех выборов на движке; false и номер хода, если выбор не принят
+    bool run(BoardEngine& board, std::size_t& failedInput) const;
+
+    static std::uint64_t zigzag(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+    static std::int64_t unzigzag(std::uint64_t value) {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+};
+
+#endif
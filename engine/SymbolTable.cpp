@@ -0,0 +1,44 @@
+#include "SymbolTable.h"
+#include <algorithm>
+#include <cctype>
+
+std::uint16_t SymbolTable::intern(const std::string& symbol) {
+    auto it = ids.find(symbol);
+    if (it != ids.end()) {
+        return it->second;
+    }
+
+    if (symbols.size() >= InvalidId) {
+        return InvalidId;
+    }
+
+    std::uint16_t id = static_cast<std::uint16_t>(symbols.size());
+    symbols.push_back(symbol);
+    imageFlags.push_back(looksLikeImage(symbol));
+    ids.emplace(symbol, id);
+    return id;
+}
+
+std::uint16_t SymbolTable::find(const std::string& symbol) const {
+    auto it = ids.find(symbol);
+    return it != ids.end() ? it->second : InvalidId;
+}
+
+void SymbolTable::clear() {
+    symbols.clear();
+    imageFlags.clear();
+    ids.clear();
+}
+
+bool SymbolTable::looksLikeImage(const std::string& symbol) {
+    // Проверяется один раз на символ, а не на каждую карту
+    std::string lowerSymbol = symbol;
+    std::transform(lowerSymbol.begin(), lowerSymbol.end(), lowerSymbol.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    return lowerSymbol.find(".png") != std::string::npos ||
+           lowerSymbol.find(".jpg") != std::string::npos ||
+           lowerSymbol.find(".jpeg") != std::string::npos ||
+           lowerSymbol.find(".bmp") != std::string::npos ||
+           lowerSymbol.find("img") != std::string::npos;  // For test images
+}
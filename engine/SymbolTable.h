@@ -0,0 +1,33 @@
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Таблица символов темы (пути к изображениям или текстовые символы).
+// Каждой строке один раз выдаётся короткий номер - он и служит номером
+// пары на поле, так что сравнение карт - одно сравнение чисел.
+class SymbolTable {
+private:
+    std::vector<std::string> symbols;
+    std::vector<bool> imageFlags;
+    std::unordered_map<std::string, std::uint16_t> ids;
+
+public:
+    static const std::uint16_t InvalidId = 0xFFFF;
+
+    // Номер символа; новый символ добавляется в таблицу
+    std::uint16_t intern(const std::string& symbol);
+    std::uint16_t find(const std::string& symbol) const;
+
+    const std::string& getSymbol(std::uint16_t id) const { return symbols[id]; }
+    bool isImage(std::uint16_t id) const { return imageFlags[id]; }
+    std::size_t size() const { return symbols.size(); }
+    void clear();
+
+    static bool looksLikeImage(const std::string& symbol);
+};
+
+#endif
@@ -1,4 +1,7 @@
 #include "Game.h"
+#include "GameArchive.h"
+#include "Log.h"
+#include "Trace.h"
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
@@ -9,7 +12,7 @@
 bool isRunningInDocker() {
     std::ifstream dockerEnv("/.dockerenv");
     if (dockerEnv.good()) {
-        std::cout << "✅ Запущено в Docker" << std::endl;
+        LOG_INFO("✅ Запущено в Docker");
         return true;
     }
     
@@ -19,50 +22,146 @@ bool isRunningInDocker() {
         while (std::getline(cgroup, line)) {
             if (line.find("docker") != std::string::npos ||
                 line.find("kubepods") != std::string::npos) {
-                std::cout << "✅ Запущено в Docker (cgroup)" << std::endl;
+                LOG_INFO("✅ Запущено в Docker (cgroup)");
                 return true;
             }
         }
     }
     
-    std::cout << "⚠ Запущено локально" << std::endl;
+    LOG_INFO("⚠ Запущено локально");
     return false;
 }
 
-int main() {
+// Работа с БД без окна:
+//   memory_game --export games.csv [--db memory_game.db]
+//   memory_game --import games.jsonl [--db memory_game.db]
+//   memory_game --rebuild-stats [--db memory_game.db]
+int runDatabaseCommand(const std::string& mode, const std::string& path, std::string dbPath) {
+    GameArchive::Format format = GameArchive::Format::CSV;
+    if (mode != "--rebuild-stats" && !GameArchive::getFormat(path, format)) {
+        std::cerr << "❌ Формат файла определяется по расширению: .csv, .jsonl или .ndjson" << std::endl;
+        return EXIT_FAILURE;
+    }
+    
+    if (dbPath.empty()) {
+        dbPath = Database::defaultPath();
+    }
+    Database database(dbPath);
+    if (!database.initialize()) {
+        return EXIT_FAILURE;
+    }
+    
+    // Сводка по игрокам заново по всем партиям
+    if (mode == "--rebuild-stats") {
+        bool success = database.rebuildPlayerStats();
+        std::cout << (success ? "✅ Сводка по игрокам пересчитана" : "❌ Не удалось пересчитать сводку")
+                  << std::endl;
+        return success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    
+    GameArchive::Stats stats;
+    std::string error;
+    bool success = mode == "--export"
+        ? GameArchive::exportGames(database, path, format, stats, error)
+        : GameArchive::importGames(database, path, format, stats, error);
+    
+    std::cout << (success ? "✅ " : "❌ ") << (mode == "--export" ? "Выгружено " : "Загружено ")
+              << stats.rows << " партий за " << stats.seconds << " с ("
+              << static_cast<long long>(stats.getRowsPerSecond()) << " строк/с)";
+    if (stats.skipped > 0) {
+        std::cout << ", пропущено строк: " << stats.skipped;
+    }
+    std::cout << std::endl;
+    if (!success) {
+        std::cerr << "❌ " << error << std::endl;
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[]) {
+    std::string commandMode;
+    std::string commandPath;
+    std::string dbPath;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "--export" || arg == "--import") && i + 1 < argc) {
+            commandMode = arg;
+            commandPath = argv[++i];
+        } else if (arg == "--rebuild-stats") {
+            commandMode = arg;
+        } else if (arg == "--db" && i + 1 < argc) {
+            dbPath = argv[++i];
+        } else {
+            std::cerr << "Использование: memory_game [--export файл | --import файл | --rebuild-stats]"
+                      << " [--db memory_game.db]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    
+    if (commandMode.empty() && !dbPath.empty()) {
+        std::cerr << "❌ --db задаётся вместе с --export, --import или --rebuild-stats" << std::endl;
+        return EXIT_FAILURE;
+    }
+    
     try {
         // Set UTF-8 locale for proper text display
         std::setlocale(LC_ALL, "C.UTF-8");
         
-        std::cout << "\n========================================" << std::endl;
-        std::cout << "        Memory Game v2.0" << std::endl;
-        std::cout << "   Курсовая работка по программированию" << std::endl;
-        std::cout << "========================================" << std::endl;
+        // Порог журнала: MEMORY_GAME_LOG=debug|info|warn|error
+        if (const char* logLevel = std::getenv("MEMORY_GAME_LOG")) {
+            LogLevel level;
+            if (Log::parseLevel(logLevel, level)) {
+                Log::setLevel(level);
+            }
+        }
+        
+        if (!commandMode.empty()) {
+            int status = runDatabaseCommand(commandMode, commandPath, dbPath);
+            Log::shutdown();
+            return status;
+        }
+        
+        LOG_INFO("========================================");
+        LOG_INFO("        Memory Game v2.0");
+        LOG_INFO("   Курсовая работка по программированию");
+        LOG_INFO("========================================");
         
         // Check environment
         bool inDocker = isRunningInDocker();
-        std::cout << "Environment: " << (inDocker ? "Docker" : "Local system") << std::endl;
+        LOG_INFO("Environment: " << (inDocker ? "Docker" : "Local system"));
+        
+        // Трасса с самого запуска: MEMORY_GAME_TRACE=trace.json
+        TRACE_THREAD("main");
+        if (const char* tracePath = std::getenv("MEMORY_GAME_TRACE")) {
+            Trace::start(tracePath);
+        }
         
         // Initialize random numbers
         std::srand(static_cast<unsigned int>(std::time(nullptr)));
         
         // Run game
-        std::cout << "Запуск игры..." << std::endl;
+        LOG_INFO("Запуск игры...");
         Game game;
-        std::cout << "Игра инициализирована" << std::endl;
+        LOG_INFO("Игра инициализирована");
         
         game.run();
         
     } catch (const std::exception& e) {
-        std::cerr << "\n========================================" << std::endl;
-        std::cerr << "ERROR: " << e.what() << std::endl;
-        std::cerr << "========================================" << std::endl;
+        LOG_ERROR("========================================");
+        LOG_ERROR("ERROR: " << e.what());
+        LOG_ERROR("========================================");
+        Trace::stop();
+        Log::shutdown();
         return EXIT_FAILURE;
     }
     
-    std::cout << "\n========================================" << std::endl;
-    std::cout << "Спасибо за игру!" << std::endl;
-    std::cout << "========================================" << std::endl;
+    // Трасса пишется, если запись ещё идёт
+    Trace::stop();
+    
+    LOG_INFO("========================================");
+    LOG_INFO("Спасибо за игру!");
+    LOG_INFO("========================================");
+    Log::shutdown();
     
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,170 @@
+// memory_replay - повтор записанных партий на максимальной скорости.
+// Раскладка восстанавливается по зерну, выборы карт проходят через тот же
+// BoardEngine, что и в игре; очки пересчитываются Player::computeScore и
+// сверяются с итогом в файле и (с --db) с записью в таблице games:
+//   ./memory_replay replays/ --db memory_game.db
+//   ./memory_replay replays/0123456789abcdef-1760000000000.mgr --repeat 10000
+#include "BoardEngine.h"
+#include "Database.h"
+#include "Player.h"
+#include "Replay.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static bool checkReplay(const std::string& path, const Replay& replay, Database* database) {
+    BoardEngine board;
+    std::size_t failedInput = 0;
+    if (!replay.run(board, failedInput)) {
+        std::cout << "❌ " << path << ": выбор #" << failedInput << " не принят движком" << std::endl;
+        return false;
+    }
+
+    if (!replay.finished) {
+        std::cout << "⚠ " << path << ": партия не завершена, ходов " << board.getMoves() << std::endl;
+        return true;
+    }
+
+    const ReplayResult& result = replay.result;
+    int score = Player::computeScore(board.getMatchedPairs(), board.getMoves(),
+                                     result.elapsedSeconds, board.getTotalPairs());
+    bool ok = true;
+
+    if (board.getMoves() != result.moves || board.getMatchedPairs() != result.matchedPairs) {
+        std::cout << "❌ " << path << ": ходы/пары " << board.getMoves() << "/" << board.getMatchedPairs()
+                  << ", в записи " << result.moves << "/" << result.matchedPairs << std::endl;
+        ok = false;
+    }
+    if (result.outcome == ReplayResult::WON && !board.isComplete()) {
+        std::cout << "❌ " << path << ": победа записана, но поле не собрано" << std::endl;
+        ok = false;
+    }
+    if (score != result.score) {
+        std::cout << "❌ " << path << ": очки " << score << ", в записи " << result.score << std::endl;
+        ok = false;
+    }
+
+    if (database) {
+        // При сдаче в таблицу пишется половина очков
+        int expected = result.outcome == ReplayResult::SURRENDERED ? score / 2 : score;
+        // Партия ищется по имени файла (games.replay). Повторы старых версий
+        // названы одним зерном (16 hex-цифр) - их ищем по зерну
+        std::string name = fs::path(path).filename().string();
+        bool legacyName = fs::path(path).stem().string().size() == 16;
+        GameRecord record;
+        bool found = database->findGameByReplay(name, record) ||
+                     (legacyName && database->findGameBySeed(replay.header.seed, record));
+        if (!found) {
+            std::cout << "⚠ " << path << ": в БД нет партии с этим повтором" << std::endl;
+        } else if (record.score != expected || record.moves != board.getMoves()) {
+            std::cout << "❌ " << path << ": в БД " << record.score << " очков, " << record.moves
+                      << " ходов; повтор даёт " << expected << " и " << board.getMoves() << std::endl;
+            ok = false;
+        }
+    }
+
+    if (ok) {
+        std::cout << "✅ " << path << ": " << replay.header.playerName << ", " << replay.header.difficulty
+                  << ", ходов " << board.getMoves() << ", очков " << score << std::endl;
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> paths;
+    std::string databasePath;
+    int repeat = 1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--db" && i + 1 < argc) {
+            databasePath = argv[++i];
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (!arg.empty() && arg[0] != '-') {
+            paths.push_back(arg);
+        } else {
+            paths.clear();
+            break;
+        }
+    }
+
+    if (paths.empty()) {
+        std::cerr << "Использование: memory_replay <файл.mgr | папка>... [--db memory_game.db] [--repeat N]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Папки разворачиваются в отсортированный список .mgr
+    std::vector<std::string> files;
+    for (const auto& path : paths) {
+        std::error_code error;
+        if (fs::is_directory(path, error)) {
+            std::vector<std::string> found;
+            for (const auto& entry : fs::directory_iterator(path, error)) {
+                if (entry.path().extension() == ".mgr") {
+                    found.push_back(entry.path().string());
+                }
+            }
+            std::sort(found.begin(), found.end());
+            files.insert(files.end(), found.begin(), found.end());
+        } else {
+            files.push_back(path);
+        }
+    }
+
+    std::unique_ptr<Database> database;
+    if (!databasePath.empty()) {
+        database = std::make_unique<Database>(databasePath);
+        if (!database->initialize()) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<Replay> replays;
+    bool allOk = true;
+
+    for (const auto& file : files) {
+        Replay replay;
+        std::string error;
+        if (!replay.load(file, error)) {
+            std::cout << "❌ " << file << ": " << error << std::endl;
+            allOk = false;
+            continue;
+        }
+
+        allOk = checkReplay(file, replay, database.get()) && allOk;
+        replays.push_back(std::move(replay));
+    }
+
+    // Повтор без проверок и вывода - воспроизводимая нагрузка на движок
+    if (repeat > 1 && !replays.empty()) {
+        BoardEngine board;
+        long long inputs = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int r = 0; r < repeat; r++) {
+            for (const auto& replay : replays) {
+                std::size_t failedInput;
+                replay.run(board, failedInput);
+                inputs += static_cast<long long>(replay.inputs.size());
+            }
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        long long games = static_cast<long long>(repeat) * replays.size();
+        std::cout << "⚡ " << games << " партий за " << seconds << " с: "
+                  << static_cast<long long>(seconds > 0 ? games / seconds : 0) << " партий/с, "
+                  << static_cast<long long>(seconds > 0 ? inputs / seconds : 0) << " выборов/с" << std::endl;
+    }
+
+    std::cout << "📊 Проверено повторов: " << replays.size() << (allOk ? ", расхождений нет" : ", есть расхождения")
+              << std::endl;
+    return allOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
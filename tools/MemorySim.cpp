@@ -0,0 +1,556 @@
+// memory_sim - безголовое моделирование партий методом Монте-Карло.
+// Играет партии на BoardEngine теми же размерами поля (getBoardSize) и
+// считает очки той же формулой (Player::computeScore), что и игра.
+// Партии делятся между потоками; на выходе - распределения ходов, времени
+// и очков по каждой сложности и стратегии в CSV или JSON, например:
+//   ./memory_sim --games 1000000 --strategy perfect,bounded --output sim.csv
+#include "BoardEngine.h"
+#include "Difficulty.h"
+#include "Player.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class Strategy {
+    RANDOM,   // каждый ход - две случайные закрытые карты
+    PERFECT,  // помнит все открытые карты
+    BOUNDED   // помнит последние N карт и со временем забывает их
+};
+
+static const char* getStrategyName(Strategy strategy) {
+    switch (strategy) {
+        case Strategy::RANDOM: return "random";
+        case Strategy::PERFECT: return "perfect";
+        case Strategy::BOUNDED: return "bounded";
+    }
+    return "unknown";
+}
+
+struct SimConfig {
+    long long games = 100000;          // партий на каждую пару (сложность, стратегия)
+    unsigned int threads = 0;          // 0 - по числу ядер
+    std::uint64_t seed = 1;
+    std::vector<Difficulty> difficulties;
+    std::vector<Strategy> strategies;
+    int memoryCapacity = 6;            // для bounded: сколько карт помнит
+    double forgetRate = 0.05;          // для bounded: шанс забыть карту за ход
+    double flipSeconds = 0.75;         // время на выбор одной карты
+    double mismatchDelay = 0.8;        // как Game::mismatchDelay
+    std::string output;                // по умолчанию - memory_sim.<format>
+    std::string format;                // csv или json; по умолчанию - по расширению output, иначе json
+};
+
+struct Distribution {
+    double mean, stddev, min, p10, p50, p90, p99, max;
+};
+
+// Гистограмма с шагом step: память зависит от разброса значений, а не от
+// числа партий. Среднее, отклонение, min и max точные, перцентили - с
+// точностью до шага (ходы и очки - целые, время - сотые секунды)
+class Histogram {
+private:
+    double step;
+    std::vector<long long> counts;
+    long long count;
+    double sum;
+    double squares;
+    double minValue;
+    double maxValue;
+
+public:
+    explicit Histogram(double step) : step(step), count(0), sum(0.0), squares(0.0), minValue(0.0), maxValue(0.0) {
+    }
+
+    void add(double value) {
+        std::size_t bin = static_cast<std::size_t>(std::llround(std::max(0.0, value) / step));
+        if (bin >= counts.size()) {
+            counts.resize(bin + 1, 0);
+        }
+        counts[bin]++;
+        minValue = count == 0 ? value : std::min(minValue, value);
+        maxValue = count == 0 ? value : std::max(maxValue, value);
+        count++;
+        sum += value;
+        squares += value * value;
+    }
+
+    void merge(const Histogram& other) {
+        if (other.count == 0) {
+            return;
+        }
+        if (other.counts.size() > counts.size()) {
+            counts.resize(other.counts.size(), 0);
+        }
+        for (std::size_t bin = 0; bin < other.counts.size(); bin++) {
+            counts[bin] += other.counts[bin];
+        }
+        minValue = count == 0 ? other.minValue : std::min(minValue, other.minValue);
+        maxValue = count == 0 ? other.maxValue : std::max(maxValue, other.maxValue);
+        count += other.count;
+        sum += other.sum;
+        squares += other.squares;
+    }
+
+    long long size() const { return count; }
+
+    Distribution describe() const {
+        Distribution d = {0, 0, 0, 0, 0, 0, 0, 0};
+        if (count == 0) {
+            return d;
+        }
+
+        d.mean = sum / count;
+        d.stddev = std::sqrt(std::max(0.0, squares / count - d.mean * d.mean));
+
+        // Значение с рангом ceil(p% * count), как в отсортированном массиве
+        auto at = [this](double p) {
+            long long rank = std::max(1LL, static_cast<long long>(std::ceil(p / 100.0 * count)));
+            long long seen = 0;
+            for (std::size_t bin = 0; bin < counts.size(); bin++) {
+                seen += counts[bin];
+                if (seen >= rank) {
+                    return bin * step;
+                }
+            }
+            return maxValue;
+        };
+        d.min = minValue;
+        d.p10 = at(10);
+        d.p50 = at(50);
+        d.p90 = at(90);
+        d.p99 = at(99);
+        d.max = maxValue;
+        return d;
+    }
+};
+
+// Итоги одной ячейки (сложность, стратегия) в одном потоке
+struct Samples {
+    Histogram moves{1.0};
+    Histogram times{0.01};
+    Histogram scores{1.0};
+    long long perfectGames = 0;
+
+    void merge(const Samples& other) {
+        moves.merge(other.moves);
+        times.merge(other.times);
+        scores.merge(other.scores);
+        perfectGames += other.perfectGames;
+    }
+};
+
+// Игрок-бот: выбирает карты и помнит увиденное
+class SimPlayer {
+private:
+    const SimConfig& config;
+    Strategy strategy;
+    std::mt19937_64& rng;
+
+    std::vector<long long> seenAt;  // момент, когда карта запомнена; -1 - не помнит
+    std::vector<int> candidates;
+    long long clock;
+    int remembered;
+
+    int pickRandom(int exclude, bool unknownOnly) {
+        candidates.clear();
+        for (int i = 0; i < static_cast<int>(seenAt.size()); i++) {
+            if (i != exclude && board().canSelect(i) && (!unknownOnly || seenAt[i] < 0)) {
+                candidates.push_back(i);
+            }
+        }
+        if (candidates.empty()) {
+            return unknownOnly ? pickRandom(exclude, false) : -1;
+        }
+        std::uniform_int_distribution<int> pick(0, static_cast<int>(candidates.size()) - 1);
+        return candidates[pick(rng)];
+    }
+
+    // Запомненная закрытая карта той же пары
+    int findKnownPartner(int index) const {
+        std::uint16_t pairId = board().getPairId(index);
+        for (int i = 0; i < static_cast<int>(seenAt.size()); i++) {
+            if (i != index && seenAt[i] >= 0 && board().getPairId(i) == pairId) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int findKnownPair(int& second) const {
+        for (int i = 0; i < static_cast<int>(seenAt.size()); i++) {
+            if (seenAt[i] >= 0) {
+                second = findKnownPartner(i);
+                if (second >= 0) {
+                    return i;
+                }
+            }
+        }
+        return -1;
+    }
+
+    void remember(int index) {
+        if (seenAt[index] < 0) {
+            remembered++;
+        }
+        seenAt[index] = clock++;
+
+        // Вытесняем самые старые воспоминания
+        if (strategy == Strategy::BOUNDED) {
+            while (remembered > config.memoryCapacity) {
+                int oldest = -1;
+                for (int i = 0; i < static_cast<int>(seenAt.size()); i++) {
+                    if (seenAt[i] >= 0 && (oldest < 0 || seenAt[i] < seenAt[oldest])) {
+                        oldest = i;
+                    }
+                }
+                forget(oldest);
+            }
+        }
+    }
+
+    void forget(int index) {
+        if (seenAt[index] >= 0) {
+            seenAt[index] = -1;
+            remembered--;
+        }
+    }
+
+    void decay() {
+        if (strategy != Strategy::BOUNDED || config.forgetRate <= 0.0) {
+            return;
+        }
+        std::bernoulli_distribution forgetting(config.forgetRate);
+        for (int i = 0; i < static_cast<int>(seenAt.size()); i++) {
+            if (seenAt[i] >= 0 && forgetting(rng)) {
+                forget(i);
+            }
+        }
+    }
+
+    BoardEngine* engine;
+    const BoardEngine& board() const { return *engine; }
+
+public:
+    SimPlayer(const SimConfig& config, Strategy strategy, std::mt19937_64& rng)
+        : config(config), strategy(strategy), rng(rng), clock(0), remembered(0), engine(nullptr) {
+    }
+
+    void start(BoardEngine& newBoard) {
+        engine = &newBoard;
+        seenAt.assign(newBoard.getCardCount(), -1);
+        candidates.reserve(newBoard.getCardCount());
+        clock = 0;
+        remembered = 0;
+    }
+
+    // Один ход: две карты. Возвращает true при совпадении
+    bool playMove() {
+        int first = -1;
+        int second = -1;
+
+        if (strategy == Strategy::RANDOM) {
+            first = pickRandom(-1, false);
+            engine->selectCard(first);
+            second = pickRandom(first, false);
+        } else {
+            first = findKnownPair(second);
+            if (first < 0) {
+                first = pickRandom(-1, true);
+                engine->selectCard(first);
+                second = findKnownPartner(first);
+                if (second < 0) {
+                    second = pickRandom(first, true);
+                }
+            } else {
+                engine->selectCard(first);
+            }
+        }
+
+        engine->selectCard(second);
+        bool matched = engine->resolve() == BoardEngine::Outcome::MATCH;
+
+        if (strategy != Strategy::RANDOM) {
+            if (matched) {
+                forget(first);
+                forget(second);
+            } else {
+                remember(first);
+                remember(second);
+            }
+            decay();
+        }
+
+        if (!matched) {
+            engine->hideMismatch();
+        }
+        return matched;
+    }
+};
+
+static void runShard(const SimConfig& config, unsigned int shard, unsigned int shardCount,
+                     std::vector<Samples>& cells) {
+    std::seed_seq seq{static_cast<std::uint32_t>(config.seed), static_cast<std::uint32_t>(config.seed >> 32), shard};
+    std::mt19937_64 rng(seq);
+    BoardEngine board;
+    std::vector<std::uint16_t> pairIds;
+
+    // Партии делятся поровну, остаток достаётся первым потокам
+    long long games = config.games / shardCount + (shard < static_cast<unsigned long long>(config.games % shardCount) ? 1 : 0);
+
+    std::size_t cell = 0;
+    for (Difficulty difficulty : config.difficulties) {
+        BoardSize size = getBoardSize(difficulty);
+
+        for (Strategy strategy : config.strategies) {
+            Samples& samples = cells[cell++];
+            SimPlayer bot(config, strategy, rng);
+
+            for (long long game = 0; game < games; game++) {
+                pairIds.clear();
+                for (int pair = 0; pair < size.totalPairs; pair++) {
+                    pairIds.push_back(static_cast<std::uint16_t>(pair));
+                    pairIds.push_back(static_cast<std::uint16_t>(pair));
+                }
+                std::shuffle(pairIds.begin(), pairIds.end(), rng);
+                board.reset(size.rows, size.cols, pairIds);
+                bot.start(board);
+
+                double seconds = 0.0;
+                while (!board.isComplete()) {
+                    seconds += 2.0 * config.flipSeconds;
+                    if (!bot.playMove()) {
+                        seconds += config.mismatchDelay;
+                    }
+                }
+
+                // Игра считает очки по целым секундам (Game::getGameSeconds)
+                int moves = board.getMoves();
+                int score = Player::computeScore(board.getMatchedPairs(), moves,
+                                                 std::floor(seconds), size.totalPairs);
+
+                samples.moves.add(moves);
+                samples.times.add(seconds);
+                samples.scores.add(score);
+                if (moves == size.totalPairs) {
+                    samples.perfectGames++;
+                }
+            }
+        }
+    }
+}
+
+struct CellReport {
+    Difficulty difficulty;
+    Strategy strategy;
+    long long games;
+    double perfectRate;
+    Distribution moves, time, score;
+};
+
+static void writeCsv(std::ostream& out, const std::vector<CellReport>& reports) {
+    out << "difficulty,strategy,games,perfect_rate";
+    for (const char* metric : {"moves", "time", "score"}) {
+        for (const char* stat : {"mean", "stddev", "min", "p10", "p50", "p90", "p99", "max"}) {
+            out << "," << metric << "_" << stat;
+        }
+    }
+    out << "\n";
+
+    for (const auto& r : reports) {
+        out << getDifficultyName(r.difficulty) << "," << getStrategyName(r.strategy) << ","
+            << r.games << "," << r.perfectRate;
+        for (const Distribution* d : {&r.moves, &r.time, &r.score}) {
+            out << "," << d->mean << "," << d->stddev << "," << d->min << "," << d->p10
+                << "," << d->p50 << "," << d->p90 << "," << d->p99 << "," << d->max;
+        }
+        out << "\n";
+    }
+}
+
+static void writeJsonDistribution(std::ostream& out, const char* name, const Distribution& d, bool last) {
+    char line[384];
+    std::snprintf(line, sizeof(line),
+                  "      \"%s\": {\"mean\": %.4f, \"stddev\": %.4f, \"min\": %.4f, \"p10\": %.4f, "
+                  "\"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f}%s\n",
+                  name, d.mean, d.stddev, d.min, d.p10, d.p50, d.p90, d.p99, d.max, last ? "" : ",");
+    out << line;
+}
+
+static void writeJson(std::ostream& out, const SimConfig& config, const std::vector<CellReport>& reports,
+                      double seconds, double gamesPerSecond) {
+    out << "{\n";
+    out << "  \"seed\": " << config.seed << ",\n";
+    out << "  \"threads\": " << config.threads << ",\n";
+    out << "  \"flip_seconds\": " << config.flipSeconds << ",\n";
+    out << "  \"mismatch_delay\": " << config.mismatchDelay << ",\n";
+    out << "  \"memory_capacity\": " << config.memoryCapacity << ",\n";
+    out << "  \"forget_rate\": " << config.forgetRate << ",\n";
+    out << "  \"wall_seconds\": " << seconds << ",\n";
+    out << "  \"games_per_second\": " << gamesPerSecond << ",\n";
+    out << "  \"cells\": [\n";
+
+    for (std::size_t i = 0; i < reports.size(); i++) {
+        const CellReport& r = reports[i];
+        out << "    {\n";
+        out << "      \"difficulty\": \"" << getDifficultyName(r.difficulty) << "\",\n";
+        out << "      \"strategy\": \"" << getStrategyName(r.strategy) << "\",\n";
+        out << "      \"games\": " << r.games << ",\n";
+        out << "      \"perfect_rate\": " << r.perfectRate << ",\n";
+        writeJsonDistribution(out, "moves", r.moves, false);
+        writeJsonDistribution(out, "time", r.time, false);
+        writeJsonDistribution(out, "score", r.score, true);
+        out << "    }" << (i + 1 < reports.size() ? "," : "") << "\n";
+    }
+
+    out << "  ]\n";
+    out << "}\n";
+}
+
+static bool parseList(const std::string& value, SimConfig& config, bool difficulties) {
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (difficulties) {
+            if (item == "easy") config.difficulties.push_back(Difficulty::EASY);
+            else if (item == "medium") config.difficulties.push_back(Difficulty::MEDIUM);
+            else if (item == "hard") config.difficulties.push_back(Difficulty::HARD);
+            else if (item == "expert") config.difficulties.push_back(Difficulty::EXPERT);
+            else return false;
+        } else {
+            if (item == "random") config.strategies.push_back(Strategy::RANDOM);
+            else if (item == "perfect") config.strategies.push_back(Strategy::PERFECT);
+            else if (item == "bounded") config.strategies.push_back(Strategy::BOUNDED);
+            else return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    SimConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--games" && hasValue) {
+            config.games = std::max(1LL, std::atoll(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            config.threads = static_cast<unsigned int>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--seed" && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--difficulty" && hasValue && parseList(argv[++i], config, true)) {
+        } else if (arg == "--strategy" && hasValue && parseList(argv[++i], config, false)) {
+        } else if (arg == "--memory" && hasValue) {
+            config.memoryCapacity = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--forget" && hasValue) {
+            config.forgetRate = std::min(1.0, std::max(0.0, std::atof(argv[++i])));
+        } else if (arg == "--flip-time" && hasValue) {
+            config.flipSeconds = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--mismatch-delay" && hasValue) {
+            config.mismatchDelay = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--format" && hasValue) {
+            config.format = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            config.output = argv[++i];
+        } else {
+            std::cerr << "Использование: memory_sim [--games N] [--threads N] [--seed N]\n"
+                      << "    [--difficulty easy,medium,hard,expert] [--strategy random,perfect,bounded]\n"
+                      << "    [--memory N] [--forget P] [--flip-time SEC] [--mismatch-delay SEC]\n"
+                      << "    [--format csv|json] [--output file]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (config.difficulties.empty()) {
+        config.difficulties = {Difficulty::EASY, Difficulty::MEDIUM, Difficulty::HARD, Difficulty::EXPERT};
+    }
+    if (config.strategies.empty()) {
+        config.strategies = {Strategy::RANDOM, Strategy::PERFECT, Strategy::BOUNDED};
+    }
+    if (config.format.empty()) {
+        bool csv = config.output.size() >= 4 && config.output.compare(config.output.size() - 4, 4, ".csv") == 0;
+        config.format = csv ? "csv" : "json";
+    }
+    if (config.format != "csv" && config.format != "json") {
+        std::cerr << "❌ Неизвестный формат: " << config.format << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (config.output.empty()) {
+        config.output = "memory_sim." + config.format;
+    }
+    if (config.threads == 0) {
+        config.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    config.threads = static_cast<unsigned int>(std::min<long long>(config.threads, config.games));
+
+    std::size_t cellCount = config.difficulties.size() * config.strategies.size();
+    long long totalGames = config.games * static_cast<long long>(cellCount);
+    std::cout << "🎲 Моделирование: " << totalGames << " партий в " << config.threads << " потоках" << std::endl;
+
+    // Каждый поток пишет только в свои ячейки - без блокировок
+    std::vector<std::vector<Samples>> shards(config.threads, std::vector<Samples>(cellCount));
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned int shard = 0; shard < config.threads; shard++) {
+        workers.emplace_back(runShard, std::cref(config), shard, config.threads, std::ref(shards[shard]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double gamesPerSecond = seconds > 0.0 ? totalGames / seconds : 0.0;
+
+    std::vector<CellReport> reports;
+    std::size_t cell = 0;
+    for (Difficulty difficulty : config.difficulties) {
+        for (Strategy strategy : config.strategies) {
+            Samples merged;
+            for (const auto& shard : shards) {
+                merged.merge(shard[cell]);
+            }
+            cell++;
+
+            CellReport report;
+            report.difficulty = difficulty;
+            report.strategy = strategy;
+            report.games = merged.moves.size();
+            report.perfectRate = report.games > 0 ? static_cast<double>(merged.perfectGames) / report.games : 0.0;
+            report.moves = merged.moves.describe();
+            report.time = merged.times.describe();
+            report.score = merged.scores.describe();
+            reports.push_back(report);
+
+            std::printf("  %-7s %-8s ходы p50 %-6.0f очки p50 %-6.0f идеальных %.2f%%\n",
+                        getDifficultyName(difficulty), getStrategyName(strategy),
+                        report.moves.p50, report.score.p50, report.perfectRate * 100.0);
+        }
+    }
+
+    std::ofstream out(config.output);
+    if (!out) {
+        std::cerr << "❌ Не удалось открыть " << config.output << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (config.format == "csv") {
+        writeCsv(out, reports);
+    } else {
+        writeJson(out, config, reports, seconds, gamesPerSecond);
+    }
+
+    std::cout << "⚡ Скорость: " << static_cast<long long>(gamesPerSecond) << " партий/с ("
+              << seconds << " с)" << std::endl;
+    std::cout << "📊 Результаты: " << config.output << std::endl;
+    return EXIT_SUCCESS;
+}
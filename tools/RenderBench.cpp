@@ -0,0 +1,255 @@
+// render_bench - внеэкранный замер отрисовки.
+// Гоняет настоящие render*-функции Game в sf::RenderTexture и пишет в JSON
+// перцентили времени кадра и число вызовов draw для каждого экрана.
+// Без GPU запускается под программным OpenGL, например:
+//   xvfb-run -a ./render_bench --frames 300 --rows 100 --output bench.json
+#include "Game.h"
+#include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class RenderBench {
+public:
+    struct Result {
+        std::string screen;
+        std::size_t cards;
+        unsigned int drawCalls;
+        double firstFrameMs;
+        std::vector<double> frameMs;
+    };
+
+private:
+    Game& game;
+    sf::RenderTexture texture;
+    int frames;
+    int warmupFrames;
+    std::string databasePath;
+
+    double renderOnce() {
+        sf::Clock clock;
+        game.renderFrame();
+        texture.display();
+        // Ждём, пока драйвер действительно нарисует кадр
+        glFinish();
+        return clock.getElapsedTime().asMicroseconds() / 1000.0;
+    }
+
+public:
+    RenderBench(Game& game, int frames)
+        : game(game), frames(frames), warmupFrames(10) {
+    }
+
+    ~RenderBench() {
+        game.renderTarget = &game.window;
+        if (!databasePath.empty()) {
+            game.leaderboard.invalidate();
+            game.persistence.reset();
+            game.database.reset();
+            std::filesystem::remove(databasePath);
+        }
+    }
+
+    bool init() {
+        sf::Vector2u size = game.window.getSize();
+        if (!texture.create(size.x, size.y)) {
+            std::cerr << "❌ Не удалось создать RenderTexture " << size.x << "x" << size.y << std::endl;
+            return false;
+        }
+
+        game.renderTarget = &texture;
+        game.player = std::make_unique<Player>("Bench");
+        return true;
+    }
+
+    Result measure(const std::string& name, GameState state) {
+        game.currentState = state;
+
+        Result result;
+        result.screen = name;
+        result.cards = state == GameState::PLAYING ? game.cards.size() : 0;
+
+        // Первый кадр после входа в состояние собирает кэш надписей
+        result.firstFrameMs = renderOnce();
+
+        for (int i = 0; i < warmupFrames; i++) {
+            renderOnce();
+        }
+
+        result.frameMs.reserve(frames);
+        for (int i = 0; i < frames; i++) {
+            result.frameMs.push_back(renderOnce());
+        }
+        result.drawCalls = game.drawCalls;
+
+        return result;
+    }
+
+    void prepareBoard(Difficulty difficulty) {
+        game.setDifficulty(difficulty);
+        game.resetGame();
+        game.isGameActive = true;
+
+        // Половина карт открыта - в кадре и рубашки, и лицевые стороны
+        for (std::size_t i = 0; i < game.cards.size(); i += 2) {
+            game.cards[i]->reveal();
+            game.cards[i]->finishFlip();
+        }
+    }
+
+    void prepareCustomBoard(int rows, int cols) {
+        game.setCustomBoardSize(rows, cols);
+        prepareBoard(Difficulty::CUSTOM);
+    }
+
+    bool prepareLeaderboard(int rows) {
+        databasePath = (std::filesystem::temp_directory_path() / "render_bench.db").string();
+        std::filesystem::remove(databasePath);
+
+        // Очередь записи держит ссылку на прежнюю БД
+        game.persistence.reset();
+        game.database = std::make_unique<Database>(databasePath);
+        if (!game.database->initialize()) {
+            return false;
+        }
+
+        for (int i = 0; i < rows; i++) {
+            GameRecord record;
+            record.playerName = "Player" + std::to_string(i + 1);
+            record.score = 10000 - i * 7;
+            record.moves = 8 + i % 20;
+            record.pairs = 8;
+            record.time = 30.0 + i % 90;
+            record.date = "2024-01-01 12:00:00";
+            record.difficulty = "Medium";
+            game.database->saveGame(record);
+        }
+
+        game.leaderboard = LeaderboardCache(rows);
+        return true;
+    }
+
+    static double percentile(std::vector<double> values, double p) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * values.size()));
+        return values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)];
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Result>& results) const {
+        const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+        sf::Vector2u size = texture.getSize();
+
+        out << "{\n";
+        out << "  \"renderer\": \"" << (renderer ? renderer : "unknown") << "\",\n";
+        out << "  \"width\": " << size.x << ",\n";
+        out << "  \"height\": " << size.y << ",\n";
+        out << "  \"frames\": " << frames << ",\n";
+        out << "  \"screens\": [\n";
+
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            double total = 0.0;
+            for (double ms : r.frameMs) {
+                total += ms;
+            }
+            double mean = r.frameMs.empty() ? 0.0 : total / r.frameMs.size();
+
+            char line[512];
+            std::snprintf(line, sizeof(line),
+                          "    {\"name\": \"%s\", \"cards\": %zu, \"draw_calls\": %u, "
+                          "\"first_frame_ms\": %.4f, \"mean_ms\": %.4f, \"p50_ms\": %.4f, "
+                          "\"p95_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f}%s\n",
+                          r.screen.c_str(), r.cards, r.drawCalls, r.firstFrameMs, mean,
+                          percentile(r.frameMs, 50), percentile(r.frameMs, 95),
+                          percentile(r.frameMs, 99), percentile(r.frameMs, 100),
+                          i + 1 < results.size() ? "," : "");
+            out << line;
+        }
+
+        out << "  ]\n";
+        out << "}\n";
+    }
+};
+
+int main(int argc, char* argv[]) {
+    int frames = 300;
+    int rows = 10;
+    std::string outputPath = "render_bench.json";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--frames" && i + 1 < argc) {
+            frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--rows" && i + 1 < argc) {
+            rows = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else {
+            std::cerr << "Использование: render_bench [--frames N] [--rows N] [--output file.json]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        Game game;
+        RenderBench bench(game, frames);
+        if (!bench.init()) {
+            return EXIT_FAILURE;
+        }
+
+        std::vector<RenderBench::Result> results;
+
+        results.push_back(bench.measure("main_menu", GameState::MAIN_MENU));
+        results.push_back(bench.measure("setup", GameState::SETUP));
+        results.push_back(bench.measure("settings", GameState::SETTINGS));
+
+        const std::pair<Difficulty, const char*> boards[] = {
+            {Difficulty::EASY, "game_easy"},
+            {Difficulty::MEDIUM, "game_medium"},
+            {Difficulty::HARD, "game_hard"},
+            {Difficulty::EXPERT, "game_expert"}
+        };
+        for (const auto& board : boards) {
+            bench.prepareBoard(board.first);
+            results.push_back(bench.measure(board.second, GameState::PLAYING));
+        }
+        
+        // Большое поле: в кадр попадает только видимая часть
+        bench.prepareCustomBoard(100, 100);
+        results.push_back(bench.measure("game_custom_100x100", GameState::PLAYING));
+
+        results.push_back(bench.measure("pause", GameState::PAUSED));
+        results.push_back(bench.measure("game_over_win", GameState::GAME_OVER_WIN));
+        results.push_back(bench.measure("game_over_lose", GameState::GAME_OVER_LOSE));
+        results.push_back(bench.measure("profile", GameState::PROFILE));
+
+        if (bench.prepareLeaderboard(rows)) {
+            results.push_back(bench.measure("leaderboard_" + std::to_string(rows), GameState::LEADERBOARD));
+        } else {
+            std::cerr << "⚠ Таблица лидеров пропущена: не удалось создать БД" << std::endl;
+        }
+
+        std::ofstream out(outputPath);
+        if (!out) {
+            std::cerr << "❌ Не удалось открыть " << outputPath << std::endl;
+            return EXIT_FAILURE;
+        }
+        bench.writeJson(out, results);
+        std::cout << "📊 Результаты замера: " << outputPath << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}